@@ -16,6 +16,9 @@ fe::LineElem::LineElem(size_t order)
     : fe::BaseElem(order, util::vtk_type_line) {
   // compute quad data
   this->init();
+
+  // cache quad data in fixed size records
+  for (const auto &qd : d_quads) d_refQuads.emplace_back(qd);
 }
 
 double fe::LineElem::elemSize(const std::vector<util::Point3> &nodes) {
@@ -83,6 +86,30 @@ std::vector<fe::QuadData> fe::LineElem::getQuadPoints(
   return qds;
 }
 
+size_t fe::LineElem::getQuadDatas(const util::Point3 *nodes,
+                                  QuadDataT *qds) const {
+  const auto detJ = nodes[1].d_x - nodes[0].d_x;
+
+  for (size_t q = 0; q < d_refQuads.size(); q++) {
+    auto &qd = qds[q];
+    qd = d_refQuads[q];
+
+    qd.d_J[0][0] = detJ;
+    qd.d_detJ = detJ;
+
+    // transform quad weight
+    qd.d_w *= detJ;
+
+    // map point to line
+    qd.d_p.d_x = qd.d_shapes[0] * nodes[0].d_x + qd.d_shapes[1] * nodes[1].d_x;
+
+    // modify derivative of shape function
+    for (size_t i = 0; i < 2; i++) qd.d_derShapes[i][0] /= detJ;
+  }
+
+  return d_refQuads.size();
+}
+
 std::vector<double> fe::LineElem::getShapes(const util::Point3 &p) {
   // N1 = (1 - xi)/2
   // N2 = (1 + xi)/2
@@ -11,10 +11,13 @@
 #include <stdint.h>
 #include <util/compare.h>
 
+#include <algorithm>
+#include <cmath>
 #include <cstdint>
 #include <fstream>
 #include <hpx/include/parallel_algorithm.hpp>
 #include <iostream>
+#include <limits>
 
 #include "inp/decks/meshDeck.h"
 #include "inp/policy.h"
@@ -25,9 +28,58 @@
 #include "tetElem.h"
 #include "util/compare.h"
 #include "util/feElementDefs.h"
+#include "util/pointGrid.h"
 #include "util/utilGeom.h"
 #include "util/utilIO.h"
 
+namespace {
+
+/*!
+ * @brief Computes key of point on Morton or Hilbert curve
+ *
+ * Hilbert key uses the transpose algorithm of J. Skilling, Programming the
+ * Hilbert curve, AIP Conf. Proc. 707 (2004).
+ *
+ * @param x Integer coordinates of point (modified)
+ * @param dim Dimension
+ * @param bits Number of bits per coordinate
+ * @param hilbert True for Hilbert curve and false for Morton curve
+ * @return key Key of point
+ */
+uint64_t curveKey(uint32_t *x, size_t dim, size_t bits, bool hilbert) {
+  if (hilbert) {
+    // inverse undo excess work
+    for (uint32_t q = uint32_t(1) << (bits - 1); q > 1; q >>= 1) {
+      uint32_t p = q - 1;
+      for (size_t i = 0; i < dim; i++) {
+        if (x[i] & q)
+          x[0] ^= p;
+        else {
+          uint32_t t = (x[0] ^ x[i]) & p;
+          x[0] ^= t;
+          x[i] ^= t;
+        }
+      }
+    }
+
+    // gray encode
+    for (size_t i = 1; i < dim; i++) x[i] ^= x[i - 1];
+    uint32_t t = 0;
+    for (uint32_t q = uint32_t(1) << (bits - 1); q > 1; q >>= 1)
+      if (x[dim - 1] & q) t ^= q - 1;
+    for (size_t i = 0; i < dim; i++) x[i] ^= t;
+  }
+
+  // interleave bits with most significant bit first
+  uint64_t key = 0;
+  for (size_t b = bits; b > 0; b--)
+    for (size_t i = 0; i < dim; i++) key = (key << 1) | ((x[i] >> (b - 1)) & 1);
+
+  return key;
+}
+
+}  // namespace
+
 fe::Mesh::Mesh(size_t dim)
     : d_numNodes(0),
       d_numElems(0),
@@ -77,6 +129,9 @@ fe::Mesh::Mesh(inp::MeshDeck *deck)
   // read mesh data from file
   createData(d_filename, false, deck->d_isCentroidBasedDiscretization);
 
+  // reorder nodes for better memory locality
+  if (!deck->d_reorderNodes.empty()) reorderNodes(deck->d_reorderNodes);
+
   // check if we need to compute mesh size
   if (deck->d_computeMeshSize) computeMeshSize();
 
@@ -122,7 +177,7 @@ void fe::Mesh::createData(const std::string &filename, bool ref_config,
   //
   std::cout << "Mesh: Reading mesh.\n";
   if (file_type == 0)
-    rw::reader::readCsvFile(filename, d_dim, &d_nodes, &d_vol);
+    rw::reader::readCsvFile(filename, d_dim, &d_nodes, &d_vol, &d_fix);
   else if (file_type == 1)
     rw::reader::readMshFile(filename, d_dim, &d_nodes, d_eType, d_numElems,
                             &d_enc, &d_nec, &d_vol, false);
@@ -197,9 +252,10 @@ void fe::Mesh::createData(const std::string &filename, bool ref_config,
   }
 
   //
-  // assign default values to fixity
+  // assign default values to fixity (if not read from mesh file)
   //
-  d_fix = std::vector<uint8_t>(d_nodes.size(), uint8_t(0));
+  if (d_fix.size() != d_nodes.size())
+    d_fix = std::vector<uint8_t>(d_nodes.size(), uint8_t(0));
 
   // if this is weak finite element simulation then check from policy if
   // volume is to be computed
@@ -219,83 +275,175 @@ void fe::Mesh::createData(const std::string &filename, bool ref_config,
 }
 
 void fe::Mesh::computeVol() {
-  // initialize quadrature data
-  fe::BaseElem *quads;
-  if (d_eType == util::vtk_type_triangle)
-    quads = new fe::TriElem(2);
-  else if (d_eType == util::vtk_type_quad)
-    quads = new fe::QuadElem(2);
-  else if (d_eType == util::vtk_type_tetra)
-    quads = new fe::TetElem(2);
-
   // check if we have valid element-node connectivity data for nodal volume
   // calculations
-  if (d_nec.size() != d_numNodes || d_enc.empty()) {
+  if (d_enc.empty() || d_eNumVertex == 0) {
     std::cerr << "Error: Can not compute nodal volume for given finite "
                  "element mesh as the element-node connectivity data is "
                  "invalid."
               << std::endl;
+    exit(1);
   }
 
-  if (false) {
-    print(0, 0);
-    std::cout << "\n-------- Node data ----------\n";
-    std::cout << util::io::printStr(d_nodes, 0) << "\n";
-    std::cout << "\n-------- Element data ----------\n";
-    std::cout << util::io::printStr(d_enc, 0) << "\n";
+  d_vol.assign(d_numNodes, 0.);
+
+  // elements of same color do not share vertex and the last list is to be
+  // processed serially
+  auto colors = colorElements();
+
+  for (size_t c = 0; c < colors.size(); c++) {
+    bool parallel = c + 1 < colors.size();
+    if (d_eType == util::vtk_type_triangle)
+      addElemVolumes(fe::TriElem(2), colors[c], parallel);
+    else if (d_eType == util::vtk_type_quad)
+      addElemVolumes(fe::QuadElem(2), colors[c], parallel);
+    else if (d_eType == util::vtk_type_tetra)
+      addElemVolumes(fe::TetElem(2), colors[c], parallel);
+    else {
+      std::cerr << "Error: Nodal volume calculation is not implemented for "
+                   "element type = " << d_eType << ".\n";
+      exit(1);
+    }
   }
+}
 
-  // check if we have volid element-node connectivity data for nodal volume
-  // calculations
-  if (d_nec.size() != d_numNodes || d_enc.empty()) {
-    std::cerr << "Error: Can not compute nodal volume for given finite "
-                 "element mesh as the element-node connectivity data is "
-                 "invalid."
-              << std::endl;
+std::vector<std::vector<size_t>> fe::Mesh::colorElements() const {
+  // bit c of mask of node is set if node belongs to element of color c
+  std::vector<uint64_t> masks(d_numNodes, 0);
+  std::vector<std::vector<size_t>> colors(65);
+
+  for (size_t e = 0; e < d_numElems; e++) {
+    uint64_t used = 0;
+    for (size_t k = 0; k < d_eNumVertex; k++)
+      used |= masks[d_enc[d_eNumVertex * e + k]];
+
+    // find first free color
+    size_t c = 0;
+    while (c < 64 && (used >> c) & 1) c++;
+
+    colors[c].push_back(e);
+    if (c == 64) continue;
+
+    for (size_t k = 0; k < d_eNumVertex; k++)
+      masks[d_enc[d_eNumVertex * e + k]] |= uint64_t(1) << c;
   }
 
-  //
-  // compute nodal volume
-  //
-  d_vol.resize(d_numNodes);
-  auto f = hpx::parallel::for_loop(
-      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
-      this->d_numNodes, [this, quads](boost::uint64_t i) {
-        double v = 0.0;
+  // remove empty colors but keep the list of uncolored elements at the end
+  auto serial = colors.back();
+  colors.pop_back();
+  colors.erase(std::remove_if(colors.begin(), colors.end(),
+                              [](const std::vector<size_t> &l) {
+                                return l.empty();
+                              }),
+               colors.end());
+  colors.push_back(serial);
+
+  return colors;
+}
 
-        for (auto e : this->d_nec[i]) {
-          std::vector<size_t> e_ns = this->getElementConnectivity(e);
+template <class ElemType>
+void fe::Mesh::addElemVolumes(const ElemType &elem,
+                              const std::vector<size_t> &elems,
+                              bool parallel) {
+  typedef typename ElemType::QuadDataT QuadDataT;
+  const size_t nv = d_eNumVertex;
+  const size_t nq = elem.getRefQuadDatas().size();
+  const size_t block = 1024;
+
+  // add contribution of elements [b * block, (b + 1) * block) in the list
+  auto add_block = [this, &elem, &elems, nv, nq, block](size_t b) {
+    std::vector<QuadDataT> qds(nq);
+    util::Point3 nodes[8];
+
+    size_t i_end = std::min(elems.size(), (b + 1) * block);
+    for (size_t i = b * block; i < i_end; i++) {
+      const size_t *e_ns = d_enc.data() + nv * elems[i];
+      for (size_t k = 0; k < nv; k++) nodes[k] = d_nodes[e_ns[k]];
+
+      elem.getQuadDatas(nodes, qds.data());
+
+      // orientation of element
+      double factor = qds[0].d_detJ < 0. ? -1. : 1.;
+
+      for (size_t k = 0; k < nv; k++) {
+        double v = 0.;
+        for (const auto &qd : qds) v += qd.d_shapes[k] * qd.d_w;
+        d_vol[e_ns[k]] += factor * v;
+      }
+    }
+  };
 
-          // locate global node i in local list of element el
-          int loc_i = -1;
-          for (size_t l = 0; l < e_ns.size(); l++)
-            if (e_ns[l] == i) loc_i = l;
+  size_t num_blocks = (elems.size() + block - 1) / block;
+  if (!parallel) {
+    for (size_t b = 0; b < num_blocks; b++) add_block(b);
+    return;
+  }
 
-          if (loc_i == -1) {
-            std::cerr << "Error: Check node element connectivity.\n";
-            exit(1);
-          }
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      num_blocks, [&add_block](boost::uint64_t b) { add_block(b); });
+  f.get();
+}
 
-          // get quad data
-          std::vector<util::Point3> e_nodes;
-          for (auto k : e_ns) e_nodes.emplace_back(this->d_nodes[k]);
+void fe::Mesh::reorderNodes(const std::string &method) {
+  if (method != "morton" && method != "hilbert") {
+    std::cerr << "Error: Reorder_Nodes = " << method << " is not supported. "
+                 "Use morton or hilbert.\n";
+    exit(1);
+  }
 
-          // get volume of element
-          double vol = quads->elemSize(e_nodes);
-          double factor = 1.;
-          if (vol < 0.) factor = -1.;
+  if (d_numNodes == 0) return;
 
-          std::vector<fe::QuadData> qds = quads->getQuadDatas(e_nodes);
+  std::cout << "Mesh: Reordering nodes along " << method << " curve.\n";
 
-          // compute V_e and add it to volume
-          for (auto qd : qds) v += qd.d_shapes[loc_i] * factor * qd.d_w;
-        }  // loop over elements
+  // number of bits per coordinate so that key fits in 64 bits
+  const size_t dim = std::max(size_t(1), std::min(size_t(3), d_dim));
+  const size_t bits = std::min(size_t(31), size_t(63 / dim));
+  const bool hilbert = method == "hilbert";
+  const double max_int = double((uint64_t(1) << bits) - 1);
 
-        // update
-        this->d_vol[i] = v;
-      });  // end of parallel for loop
+  // scale of each direction
+  double scale[3];
+  for (size_t k = 0; k < 3; k++) {
+    double l = d_bbox.second[k] - d_bbox.first[k];
+    scale[k] = l > 0. ? max_int / l : 0.;
+  }
 
+  // compute keys
+  std::vector<uint64_t> keys(d_numNodes);
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      d_numNodes,
+      [this, &keys, &scale, dim, bits, hilbert, max_int](boost::uint64_t i) {
+        uint32_t x[3];
+        for (size_t k = 0; k < dim; k++) {
+          double s = (d_nodes[i][k] - d_bbox.first[k]) * scale[k];
+          x[k] = uint32_t(std::max(0., std::min(max_int, s)));
+        }
+        keys[i] = curveKey(x, dim, bits, hilbert);
+      });
   f.get();
+
+  // new order of nodes (ties are broken by original id)
+  d_origNodeIds.resize(d_numNodes);
+  for (size_t i = 0; i < d_numNodes; i++) d_origNodeIds[i] = i;
+  std::sort(d_origNodeIds.begin(), d_origNodeIds.end(),
+            [&keys](const size_t &a, const size_t &b) {
+              return keys[a] < keys[b] || (keys[a] == keys[b] && a < b);
+            });
+
+  // new id of nodes
+  std::vector<size_t> new_ids(d_numNodes);
+  for (size_t i = 0; i < d_numNodes; i++) new_ids[d_origNodeIds[i]] = i;
+
+  // permute nodal data
+  fromOriginalOrder(&d_nodes);
+  fromOriginalOrder(&d_vol);
+  fromOriginalOrder(&d_fix);
+  fromOriginalOrder(&d_nec);
+
+  // update element-node connectivity
+  for (auto &n : d_enc) n = new_ids[n];
 }
 
 void fe::Mesh::computeBBox() {
@@ -314,27 +462,72 @@ void fe::Mesh::computeBBox() {
 }
 
 void fe::Mesh::computeMeshSize() {
-  double guess = 0.;
-  if (d_nodes.size() < 2) {
+  d_closeNodePairs.clear();
+  size_t n = d_nodes.size();
+  if (n < 2) {
     d_h = 0.;
     return;
   }
 
-  guess = (d_nodes[0] - d_nodes[1]).length();
-  for (size_t i = 0; i < d_nodes.size(); i++)
-    for (size_t j = 0; j < d_nodes.size(); j++)
-      if (i != j) {
-        double val = d_nodes[i].dist(d_nodes[j]);
-
-        if (util::compare::definitelyLessThan(val, 1.0E-12)) {
-          std::cout << "Check nodes are too close = "
-                    << util::io::printStr<util::Point3>(
-                           {d_nodes[i], d_nodes[j]})
-                    << "\n";
-          std::cout << "Distance = " << val << ", guess = " << guess << "\n";
-        }
-        if (util::compare::definitelyLessThan(val, guess)) guess = val;
-      }
+  // typical spacing of nodes from bounding box
+  double vol = 1.;
+  size_t dim = 0;
+  for (size_t dof = 0; dof < 3; dof++) {
+    double ext = d_bbox.second[dof] - d_bbox.first[dof];
+    if (util::compare::definitelyGreaterThan(ext, 0.)) {
+      vol *= ext;
+      dim++;
+    }
+  }
+  double r = dim > 0 ? std::pow(vol / double(n), 1. / double(dim)) : 1.;
+
+  auto grid = util::PointGrid(&d_nodes, r);
+
+  // minimum distance of node to other nodes within radius r. If the
+  // minimum over all nodes is found, it is the exact mesh size as any pair
+  // closer than that is within radius r. Otherwise radius is doubled.
+  std::vector<double> min_dist(n, 0.);
+  std::vector<std::vector<size_t>> close_nodes(n);
+  double guess = std::numeric_limits<double>::max();
+  while (guess == std::numeric_limits<double>::max()) {
+    auto f = hpx::parallel::for_loop(
+        hpx::parallel::execution::par(hpx::parallel::execution::task), 0, n,
+        [this, &grid, &min_dist, &close_nodes, r](boost::uint64_t i) {
+          std::vector<size_t> list;
+          grid.findInBall(d_nodes[i], r, &list);
+
+          double d_min = std::numeric_limits<double>::max();
+          close_nodes[i].clear();
+          for (auto j : list) {
+            if (j == i) continue;
+
+            double val = d_nodes[i].dist(d_nodes[j]);
+            if (j > i && util::compare::definitelyLessThan(val, 1.0E-12))
+              close_nodes[i].push_back(j);
+            if (val < d_min) d_min = val;
+          }
+          min_dist[i] = d_min;
+        });
+    f.get();
+
+    guess = *std::min_element(min_dist.begin(), min_dist.end());
+    r *= 2.;
+  }
+
+  for (size_t i = 0; i < n; i++)
+    for (auto j : close_nodes[i]) d_closeNodePairs.emplace_back(i, j);
+
+  if (!d_closeNodePairs.empty()) {
+    std::cout << "Check nodes are too close. Number of pairs = "
+              << d_closeNodePairs.size() << "\n";
+    for (size_t k = 0; k < std::min(d_closeNodePairs.size(), size_t(10)); k++)
+      std::cout << "  Nodes (" << d_closeNodePairs[k].first << ", "
+                << d_closeNodePairs[k].second << ") = "
+                << util::io::printStr<util::Point3>(
+                       {d_nodes[d_closeNodePairs[k].first],
+                        d_nodes[d_closeNodePairs[k].second]})
+                << "\n";
+  }
 
   d_h = guess;
 }
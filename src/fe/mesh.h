@@ -115,6 +115,56 @@ public:
    */
   double getMeshSize() const { return d_h; };
 
+  /*!
+   * @brief Get the pairs of nodes which are too close (closer than 1.0E-12)
+   *
+   * List is filled when mesh size is computed. In each pair, id of first
+   * node is smaller than id of second node.
+   *
+   * @return pairs List of pairs of node ids
+   */
+  const std::vector<std::pair<size_t, size_t>> &getCloseNodePairs() const {
+    return d_closeNodePairs;
+  };
+
+  /*!
+   * @brief Get the original ids of nodes
+   *
+   * If nodes are reordered, entry i is the id of node i in the mesh file.
+   * Otherwise the list is empty.
+   *
+   * @return ids List of original ids
+   */
+  const std::vector<size_t> &getOriginalNodeIds() const {
+    return d_origNodeIds;
+  };
+
+  /*!
+   * @brief Permutes nodal data from original order of nodes (as in mesh
+   * file) to the current order
+   *
+   * @param data Pointer to nodal data
+   */
+  template <class T> void fromOriginalOrder(std::vector<T> *data) const {
+    if (d_origNodeIds.empty() || data->size() != d_numNodes) return;
+    auto old = *data;
+    for (size_t i = 0; i < d_numNodes; i++)
+      (*data)[i] = old[d_origNodeIds[i]];
+  };
+
+  /*!
+   * @brief Permutes nodal data from current order of nodes to the original
+   * order (as in mesh file)
+   *
+   * @param data Pointer to nodal data
+   */
+  template <class T> void toOriginalOrder(std::vector<T> *data) const {
+    if (d_origNodeIds.empty() || data->size() != d_numNodes) return;
+    auto old = *data;
+    for (size_t i = 0; i < d_numNodes; i++)
+      (*data)[d_origNodeIds[i]] = old[i];
+  };
+
   /*!
    * @brief Get coordinates of node i
    * @param i Id of the node
@@ -218,6 +268,27 @@ public:
     return nds;
   };
 
+  /*!
+   * @brief Get the elements sharing the node
+   *
+   * Node-element connectivity is available only if element data is read
+   * from the mesh file (see fe::Mesh::d_nec).
+   *
+   * @param i Id of node
+   * @return vector Vector of element ids
+   */
+  const std::vector<size_t> &getNodeElementConnectivity(const size_t &i) const {
+    return d_nec[i];
+  };
+
+  /*!
+   * @brief Check if node-element connectivity data is available
+   * @return bool True if data is available
+   */
+  bool hasNodeElementConnectivity() const {
+    return d_nec.size() == d_nodes.size() && !d_nodes.empty();
+  };
+
   /*!
    * @brief Get the reference to element-node connectivity data
    * @return reference Reference
@@ -345,7 +416,8 @@ private:
    *
    * This function calls reader methods in namespace rw::reader to read the
    * mesh file. For finite difference implementation, we support **.csv** mesh
-   * file which has nodal coordinates and nodal volumes data.
+   * file which has nodal coordinates and nodal volumes data and optionally
+   * nodal fixity data.
    *
    * However, for finite element implementation, we require either **.vtu** or
    * **.msh** file with element-node connectivity data.
@@ -372,9 +444,41 @@ private:
    * where \f$\mathbf{N}_i\f$ is a list of elements which have node \f$ i\f$
    * as its vertex, \f$ T_e\f$ is the element domain, \f$ N_i\f$ is the shape
    * function of the node \f$ i\f$ in element e.
+   *
+   * Loop is over elements so that quadrature of each element is computed
+   * once, and the integrals are added to the volume of its vertices.
+   * Elements are colored so that elements of same color do not share a
+   * vertex, and elements of each color are processed in parallel without
+   * write conflicts.
    */
   void computeVol();
 
+  /*!
+   * @brief Colors elements so that no two elements of same color share a
+   * vertex
+   *
+   * Greedy coloring with at most 64 colors is used. Elements which can not be
+   * colored are returned as the last list and must be processed serially.
+   *
+   * @return colors List of elements for each color
+   */
+  std::vector<std::vector<size_t>> colorElements() const;
+
+  /*!
+   * @brief Adds integral of shape functions over elements to nodal volume
+   *
+   * Integrals are multiplied by -1 if element has negative orientation.
+   *
+   * @tparam ElemType Type of element, e.g. fe::TriElem
+   * @param elem Element with quadrature data
+   * @param elems List of element ids
+   * @param parallel True if elements do not share vertices and can be
+   * processed in parallel
+   */
+  template <class ElemType>
+  void addElemVolumes(const ElemType &elem, const std::vector<size_t> &elems,
+                      bool parallel);
+
   /*! @brief Compute the bounding box  */
   void computeBBox();
 
@@ -382,10 +486,27 @@ private:
    * @brief Compute the mesh size
    *
    * This method searches for minimum distance between any two mesh nodes and
-   * stores it as a mesh size.
+   * stores it as a mesh size. Nodes are sorted into grid and each node only
+   * checks nodes in ball of radius equal to typical node spacing (radius is
+   * doubled if no pair is found), so that the cost is nearly linear in
+   * number of nodes. Pairs of nodes which are too close are stored in
+   * d_closeNodePairs.
    */
   void computeMeshSize();
 
+  /*!
+   * @brief Reorders nodes along space filling curve
+   *
+   * Nodes are sorted by their key on Morton (Z-order) or Hilbert curve over
+   * the bounding box so that nodes close in space are close in memory. This
+   * improves cache use in loops over neighbors of nodes. Nodal volume,
+   * fixity and element-node connectivity are permuted accordingly and
+   * original ids of nodes are stored in d_origNodeIds.
+   *
+   * @param method Space filling curve, \a morton or \a hilbert
+   */
+  void reorderNodes(const std::string &method);
+
   /** @}*/
 
   /**
@@ -510,8 +631,14 @@ private:
   /*! @brief Mesh size */
   double d_h;
 
+  /*! @brief Pairs of nodes which are too close */
+  std::vector<std::pair<size_t, size_t>> d_closeNodePairs;
+
   /*! @brief Specify if we keep the element connectivity data */
   bool d_keepElementConn;
+
+  /*! @brief Original ids of nodes if nodes are reordered */
+  std::vector<size_t> d_origNodeIds;
 };
 
 } // namespace fe
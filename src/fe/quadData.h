@@ -11,6 +11,7 @@
 
 #include <util/point.h>           // definition of Point3
 #include <util/utilIO.h>
+#include <array>
 #include <vector>
 
 namespace fe {
@@ -101,6 +102,71 @@ struct QuadData {
   void print(int nt = 0, int lvl = 0) const { std::cout << printStr(nt, lvl); };
 };
 
+/*!
+ * @brief A struct to store the quadrature data of element with fixed number
+ * of vertices and fixed dimension
+ *
+ * This is the fixed size counterpart of fe::QuadData. All data is stored in
+ * arrays whose size is known at compile time, so that records can be
+ * created on stack and copied without memory allocation. Elements cache these
+ * records for reference element, see for example fe::TriElem::getQuadDatas(
+ * const util::Point3 *, QuadDataT *) const.
+ *
+ * @tparam N Number of vertices of element
+ * @tparam D Dimension of element
+ */
+template <size_t N, size_t D> struct QuadDataFixed {
+
+  /*! @brief Quadrature weight */
+  double d_w;
+
+  /*! @brief Quadrature point in 1-d, 2-d or 3-d */
+  util::Point3 d_p;
+
+  /*! @brief Value of shape functions at quad point p */
+  std::array<double, N> d_shapes;
+
+  /*!
+   * @brief Value of derivative of shape functions at quad point p
+   *
+   * x-derivative of ith shape function is d_derShapes[i][0]
+   */
+  std::array<std::array<double, D>, N> d_derShapes;
+
+  /*! @brief Jacobian of the map from reference element to the element */
+  std::array<std::array<double, D>, D> d_J;
+
+  /*!
+   * @brief Determinant of the Jacobian of the map from reference element to
+   * the element
+   */
+  double d_detJ;
+
+  /*!
+   * @brief Constructor
+   */
+  QuadDataFixed() : d_w(0.), d_p(util::Point3()), d_shapes(), d_derShapes(),
+                    d_J(), d_detJ(0.){};
+
+  /*!
+   * @brief Constructor
+   *
+   * @param qd Quadrature data of same element type
+   */
+  explicit QuadDataFixed(const fe::QuadData &qd)
+      : d_w(qd.d_w), d_p(qd.d_p), d_shapes(), d_derShapes(), d_J(),
+        d_detJ(qd.d_detJ) {
+    for (size_t i = 0; i < N && i < qd.d_shapes.size(); i++)
+      d_shapes[i] = qd.d_shapes[i];
+    for (size_t i = 0; i < N && i < qd.d_derShapes.size(); i++)
+      for (size_t k = 0; k < D && k < qd.d_derShapes[i].size(); k++)
+        d_derShapes[i][k] = qd.d_derShapes[i][k];
+    for (size_t i = 0; i < D && i < qd.d_J.size(); i++)
+      for (size_t k = 0; k < D && k < qd.d_J[i].size(); k++)
+        d_J[i][k] = qd.d_J[i][k];
+  };
+};
+
 } // namespace fe
 
 #endif // FE_QUADDATA_H
@@ -14,6 +14,9 @@ fe::QuadElem::QuadElem(size_t order)
     : fe::BaseElem(order, util::vtk_type_quad) {
   // compute quad data
   this->init();
+
+  // cache quad data in fixed size records
+  for (const auto &qd : d_quads) d_refQuads.emplace_back(qd);
 }
 
 double fe::QuadElem::elemSize(const std::vector<util::Point3> &nodes) {
@@ -84,6 +87,44 @@ std::vector<fe::QuadData> fe::QuadElem::getQuadPoints(
   return qds;
 }
 
+size_t fe::QuadElem::getQuadDatas(const util::Point3 *nodes,
+                                  QuadDataT *qds) const {
+  for (size_t q = 0; q < d_refQuads.size(); q++) {
+    auto &qd = qds[q];
+    const auto &ref = d_refQuads[q];
+
+    // Jacobian depends on quad point for bilinear map
+    qd.d_J = {{{0., 0.}, {0., 0.}}};
+    for (size_t i = 0; i < 4; i++)
+      for (size_t a = 0; a < 2; a++) {
+        qd.d_J[a][0] += ref.d_derShapes[i][a] * nodes[i].d_x;
+        qd.d_J[a][1] += ref.d_derShapes[i][a] * nodes[i].d_y;
+      }
+    const auto &J = qd.d_J;
+    qd.d_detJ = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+
+    // transform quad weight
+    qd.d_w = ref.d_w * qd.d_detJ;
+
+    // map point to quadrangle
+    qd.d_shapes = ref.d_shapes;
+    qd.d_p = util::Point3();
+    for (size_t i = 0; i < 4; i++) {
+      qd.d_p.d_x += ref.d_shapes[i] * nodes[i].d_x;
+      qd.d_p.d_y += ref.d_shapes[i] * nodes[i].d_y;
+    }
+
+    // derivatives of shape function
+    for (size_t i = 0; i < 4; i++) {
+      const auto &d = ref.d_derShapes[i];
+      qd.d_derShapes[i][0] = (d[0] * J[1][1] - d[1] * J[0][1]) / qd.d_detJ;
+      qd.d_derShapes[i][1] = (-d[0] * J[1][0] + d[1] * J[0][0]) / qd.d_detJ;
+    }
+  }
+
+  return d_refQuads.size();
+}
+
 std::vector<double> fe::QuadElem::getShapes(const util::Point3 &p) {
   // N1 = (1 - xi)(1 - eta)/4
   // N2 = (1 + xi)(1 - eta)/4
@@ -154,6 +154,29 @@ public:
   std::vector<fe::QuadData>
   getQuadPoints(const std::vector<util::Point3> &nodes) override;
 
+  /*! @brief Fixed size quadrature data of quadrangle element */
+  typedef fe::QuadDataFixed<4, 2> QuadDataT;
+
+  /*!
+   * @brief Returns the cached quadrature data of reference element
+   *
+   * @return vector Vector of fixed size quadrature data
+   */
+  const std::vector<QuadDataT> &getRefQuadDatas() const { return d_refQuads; }
+
+  /*!
+   * @brief Get quadrature data without memory allocation
+   *
+   * Same as fe::QuadElem::getQuadDatas(const std::vector<util::Point3> &) but
+   * the reference data cached in constructor is mapped to the element and
+   * written to the records provided by the caller.
+   *
+   * @param nodes Pointer to four vertices of element
+   * @param qds Pointer to array of size at least getRefQuadDatas().size()
+   * @return n Number of quadrature points
+   */
+  size_t getQuadDatas(const util::Point3 *nodes, QuadDataT *qds) const;
+
   /*!
    * @brief Returns the string containing information about the instance of
    * the object
@@ -209,6 +232,9 @@ private:
    */
   void init() override;
 
+  /*! @brief Quadrature data of reference element in fixed size records */
+  std::vector<QuadDataT> d_refQuads;
+
 };
 
 } // namespace fe
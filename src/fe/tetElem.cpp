@@ -68,6 +68,9 @@ fe::TetElem::TetElem(size_t order)
 
   // compute quad data
   this->init();
+
+  // cache quad data in fixed size records
+  for (const auto &qd : d_quads) d_refQuads.emplace_back(qd);
 }
 
 double fe::TetElem::elemSize(const std::vector<util::Point3> &nodes) {
@@ -165,6 +168,60 @@ std::vector<fe::QuadData> fe::TetElem::getQuadPoints(
   return qds;
 }
 
+size_t fe::TetElem::getQuadDatas(const util::Point3 *nodes,
+                                 QuadDataT *qds) const {
+  // Jacobian is constant for linear tetrahedron
+  double J[3][3];
+  for (size_t a = 0; a < 3; a++) {
+    J[a][0] = nodes[a + 1].d_x - nodes[0].d_x;
+    J[a][1] = nodes[a + 1].d_y - nodes[0].d_y;
+    J[a][2] = nodes[a + 1].d_z - nodes[0].d_z;
+  }
+  const auto detJ = J[0][0] * (J[1][1] * J[2][2] - J[2][1] * J[1][2]) -
+                    J[0][1] * (J[1][0] * J[2][2] - J[2][0] * J[1][2]) +
+                    J[0][2] * (J[1][0] * J[2][1] - J[2][0] * J[1][1]);
+
+  // inverse of Jacobian using cofactors
+  double J_inv[3][3];
+  for (size_t a = 0; a < 3; a++)
+    for (size_t b = 0; b < 3; b++) {
+      size_t a1 = (a + 1) % 3, a2 = (a + 2) % 3;
+      size_t b1 = (b + 1) % 3, b2 = (b + 2) % 3;
+      J_inv[a][b] = (J[b1][a1] * J[b2][a2] - J[b1][a2] * J[b2][a1]) / detJ;
+    }
+
+  for (size_t q = 0; q < d_refQuads.size(); q++) {
+    auto &qd = qds[q];
+    const auto &ref = d_refQuads[q];
+
+    for (size_t a = 0; a < 3; a++)
+      for (size_t b = 0; b < 3; b++) qd.d_J[a][b] = J[a][b];
+    qd.d_detJ = detJ;
+
+    // transform quad weight
+    qd.d_w = ref.d_w * detJ;
+
+    // map point to tetrahedron
+    qd.d_shapes = ref.d_shapes;
+    qd.d_p = util::Point3();
+    for (size_t i = 0; i < 4; i++) {
+      qd.d_p.d_x += ref.d_shapes[i] * nodes[i].d_x;
+      qd.d_p.d_y += ref.d_shapes[i] * nodes[i].d_y;
+      qd.d_p.d_z += ref.d_shapes[i] * nodes[i].d_z;
+    }
+
+    // grad N_i = J_inv * grad N_i^ref
+    for (size_t i = 0; i < 4; i++)
+      for (size_t a = 0; a < 3; a++) {
+        qd.d_derShapes[i][a] = 0.;
+        for (size_t b = 0; b < 3; b++)
+          qd.d_derShapes[i][a] += J_inv[a][b] * ref.d_derShapes[i][b];
+      }
+  }
+
+  return d_refQuads.size();
+}
+
 std::vector<double> fe::TetElem::getShapes(const util::Point3 &p) {
   // N1 = 1 - xi - eta - zeta, N2 = xi, N3 = eta, N4 = zeta
   return std::vector<double>{1. - p.d_x - p.d_y - p.d_z, p.d_x, p.d_y, p.d_z};
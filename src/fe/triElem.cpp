@@ -17,6 +17,9 @@ fe::TriElem::TriElem(size_t order)
     : fe::BaseElem(order, util::vtk_type_triangle) {
   // compute quad data
   this->init();
+
+  // cache quad data in fixed size records
+  for (const auto &qd : d_quads) d_refQuads.emplace_back(qd);
 }
 
 double fe::TriElem::elemSize(const std::vector<util::Point3> &nodes) {
@@ -111,6 +114,43 @@ std::vector<fe::QuadData> fe::TriElem::getQuadPoints(
   return qds;
 }
 
+size_t fe::TriElem::getQuadDatas(const util::Point3 *nodes,
+                                 QuadDataT *qds) const {
+  // Jacobian is constant for linear triangle
+  const double J[2][2] = {
+      {nodes[1].d_x - nodes[0].d_x, nodes[1].d_y - nodes[0].d_y},
+      {nodes[2].d_x - nodes[0].d_x, nodes[2].d_y - nodes[0].d_y}};
+  const auto detJ = J[0][0] * J[1][1] - J[0][1] * J[1][0];
+
+  for (size_t q = 0; q < d_refQuads.size(); q++) {
+    auto &qd = qds[q];
+    const auto &ref = d_refQuads[q];
+
+    qd.d_J = {{{J[0][0], J[0][1]}, {J[1][0], J[1][1]}}};
+    qd.d_detJ = detJ;
+
+    // transform quad weight
+    qd.d_w = ref.d_w * detJ;
+
+    // map point to triangle
+    qd.d_shapes = ref.d_shapes;
+    qd.d_p = util::Point3();
+    for (size_t i = 0; i < 3; i++) {
+      qd.d_p.d_x += ref.d_shapes[i] * nodes[i].d_x;
+      qd.d_p.d_y += ref.d_shapes[i] * nodes[i].d_y;
+    }
+
+    // derivatives of shape function
+    for (size_t i = 0; i < 3; i++) {
+      const auto &d = ref.d_derShapes[i];
+      qd.d_derShapes[i][0] = (d[0] * J[1][1] - d[1] * J[0][1]) / detJ;
+      qd.d_derShapes[i][1] = (-d[0] * J[1][0] + d[1] * J[0][0]) / detJ;
+    }
+  }
+
+  return d_refQuads.size();
+}
+
 std::vector<double> fe::TriElem::getShapes(const util::Point3 &p) {
   // N1 = 1 - xi - eta, N2 = xi, N3 = eta
   return std::vector<double>{1. - p.d_x - p.d_y, p.d_x, p.d_y};
@@ -106,6 +106,14 @@ protected:
    */
   void computeDampingCoefficient(const fe::Mesh *mesh);
 
+  /*!
+   * @brief Compute damping coefficient at a point
+   *
+   * @param x Nodal coordinate
+   * @return coeff Damping coefficient (zero if outside damping regions)
+   */
+  double computeCoefficient(const util::Point3 &x) const;
+
   /*! @brief Dimension */
   size_t d_dim;
 
@@ -8,38 +8,64 @@
 
 #include "fracture.h"
 
+#include <algorithm>
+#include <bitset>
 #include <hpx/include/parallel_algorithm.hpp>
 
 #include "inp/decks/fractureDeck.h"
+#include "util/pointGrid.h"
 #include "util/utilGeom.h"
 #include "util/utilIO.h"
 
 geometry::Fracture::Fracture(inp::FractureDeck *deck)
-    : d_fractureDeck_p(deck) {}
+    : d_fractureDeck_p(deck), d_searchRadius(0.) {}
 
 geometry::Fracture::Fracture(
     inp::FractureDeck *deck, const std::vector<util::Point3> *nodes,
     const std::vector<std::vector<size_t>> *neighbor_list)
-    : d_fractureDeck_p(deck) {
-  d_fracture.resize(neighbor_list->size());
-
+    : d_fractureDeck_p(deck), d_searchRadius(0.) {
+  // number of words needed by each node
+  d_offset.resize(neighbor_list->size() + 1, 0);
+  for (size_t i = 0; i < neighbor_list->size(); i++)
+    d_offset[i + 1] = d_offset[i] + ((*neighbor_list)[i].size() + 63) / 64;
+  d_fracture = std::vector<uint64_t>(d_offset.back(), uint64_t(0));
+
+  // maximum bond length
+  std::vector<double> max_length(neighbor_list->size(), 0.);
   auto f = hpx::parallel::for_loop(
       hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
-      neighbor_list->size(), [this, nodes, neighbor_list](boost::uint64_t i) {
-        auto ns = (*neighbor_list)[i];
-
-        size_t s = ns.size() / 8;
-        if (s * 8 < ns.size()) s++;
-        d_fracture[i] = std::vector<uint8_t>(s, uint8_t(0));
-
-        for (auto &crack : d_fractureDeck_p->d_cracks)
-          if (crack.d_activationTime < 0.) {
-            this->computeFracturedBondFd(i, &crack, nodes, &ns);
-            crack.d_crackAcrivated = true;
-          }
+      neighbor_list->size(),
+      [nodes, neighbor_list, &max_length](boost::uint64_t i) {
+        const auto &xi = (*nodes)[i];
+        for (const auto &j : (*neighbor_list)[i])
+          max_length[i] = std::max(max_length[i], xi.dist((*nodes)[j]));
       });  // end of parallel for loop
-
   f.get();
+  for (const auto &l : max_length) d_searchRadius = std::max(d_searchRadius, l);
+
+  // add small tolerance to account for comparison of crack with nodes
+  d_searchRadius *= 1.01;
+
+  // apply cracks which are present at the beginning
+  util::PointGrid grid;
+  for (auto &crack : d_fractureDeck_p->d_cracks)
+    if (crack.d_activationTime < 0.) {
+      if (grid.empty() && d_searchRadius > 0.)
+        grid.build(nodes, d_searchRadius);
+
+      applyCrack(&crack, grid, nodes, neighbor_list);
+      crack.d_crackAcrivated = true;
+    }
+}
+
+geometry::Fracture::Fracture(const geometry::Fracture &fracture,
+                             inp::FractureDeck *deck)
+    : geometry::Fracture(fracture) {
+  d_fractureDeck_p = deck;
+
+  // cracks present at the beginning are already in the copied state
+  for (auto &crack : d_fractureDeck_p->d_cracks)
+    if (crack.d_activationTime < 0.) crack.d_crackAcrivated = true;
 }
 
 bool geometry::Fracture::addCrack(
@@ -50,16 +76,9 @@ bool geometry::Fracture::addCrack(
       if (util::compare::definitelyLessThan(crack.d_activationTime, time)) {
         std::cout << "Fracture: Adding crack to system\n";
 
-        auto f = hpx::parallel::for_loop(
-            hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
-            neighbor_list->size(),
-            [this, nodes, neighbor_list, &crack](boost::uint64_t i) {
-              auto ns = (*neighbor_list)[i];
-
-              this->computeFracturedBondFd(i, &crack, nodes, &ns);
-            });  // end of parallel for loop
-
-        f.get();
+        util::PointGrid grid;
+        if (d_searchRadius > 0.) grid.build(nodes, d_searchRadius);
+        applyCrack(&crack, grid, nodes, neighbor_list);
 
         crack.d_crackAcrivated = true;
 
@@ -71,6 +90,36 @@ bool geometry::Fracture::addCrack(
   return false;
 }
 
+void geometry::Fracture::applyCrack(
+    inp::EdgeCrack *crack, const util::PointGrid &grid,
+    const std::vector<util::Point3> *nodes,
+    const std::vector<std::vector<size_t>> *neighbor_list) {
+  // grid is empty if there are no bonds
+  if (grid.empty()) return;
+
+  // nodes in bounding box of crack line enlarged by search radius
+  auto x_min = util::Point3(std::min(crack->d_pb.d_x, crack->d_pt.d_x),
+                            std::min(crack->d_pb.d_y, crack->d_pt.d_y),
+                            std::min(crack->d_pb.d_z, crack->d_pt.d_z));
+  auto x_max = util::Point3(std::max(crack->d_pb.d_x, crack->d_pt.d_x),
+                            std::max(crack->d_pb.d_y, crack->d_pt.d_y),
+                            std::max(crack->d_pb.d_z, crack->d_pt.d_z));
+  auto r = util::Point3(d_searchRadius, d_searchRadius, d_searchRadius);
+
+  std::vector<size_t> list;
+  grid.findInBox(x_min - r, x_max + r, &list);
+
+  // each node modifies only its own bonds
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      list.size(),
+      [this, crack, nodes, neighbor_list, &list](boost::uint64_t k) {
+        auto i = list[k];
+        this->computeFracturedBondFd(i, crack, nodes, &(*neighbor_list)[i]);
+      });  // end of parallel for loop
+  f.get();
+}
+
 void geometry::Fracture::computeFracturedBondFd(
     const size_t &i, inp::EdgeCrack *crack,
     const std::vector<util::Point3> *nodes,
@@ -162,32 +211,30 @@ void geometry::Fracture::computeFracturedBondFd(
 void geometry::Fracture::setBondState(const size_t &i, const size_t &j,
                                       const bool &state) {
   // to set i^th bit as true of integer a,
-  // a |= 1UL << (i % 8)
+  // a |= 1 << (i % 64)
 
   // to set i^th bit as false of integer a,
-  // a &= ~(1UL << (i % 8))
+  // a &= ~(1 << (i % 64))
 
-  state ? (d_fracture[i][j / 8] |= 1UL << (j % 8))
-        : (d_fracture[i][j / 8] &= ~(1UL << (j % 8)));
+  auto &word = d_fracture[d_offset[i] + j / 64];
+  state ? (word |= uint64_t(1) << (j % 64))
+        : (word &= ~(uint64_t(1) << (j % 64)));
 }
 
 bool geometry::Fracture::getBondState(const size_t &i, const size_t &j) const {
-  //  if (d_fracture.size() <= i) {
-  //    std::cerr << "Error: Size of fracture data is invalid\n";
-  //    exit(1);
-  //  }
-  //
-  //  if (d_fracture[i].size() <= j / 8) {
-  //    std::cerr << "Error: Size of fracture data at node " << i << " is
-  //    invalid\n"; exit(1);
-  //  }
+  return d_fracture[d_offset[i] + j / 64] >> (j % 64) & uint64_t(1);
+}
 
-  auto bond = d_fracture[i][j / 8];
-  return bond >> (j % 8) & 1UL;
+std::vector<uint64_t> geometry::Fracture::getBonds(const size_t &i) const {
+  return std::vector<uint64_t>(d_fracture.begin() + d_offset[i],
+                               d_fracture.begin() + d_offset[i + 1]);
 }
 
-std::vector<uint8_t> geometry::Fracture::getBonds(const size_t &i) const {
-  return d_fracture[i];
+size_t geometry::Fracture::getNumFracturedBonds(const size_t &i) const {
+  size_t n = 0;
+  for (size_t k = d_offset[i]; k < d_offset[i + 1]; k++)
+    n += std::bitset<64>(d_fracture[k]).count();
+  return n;
 }
 
 std::string geometry::Fracture::printStr(int nt, int lvl) const {
@@ -195,7 +242,9 @@ std::string geometry::Fracture::printStr(int nt, int lvl) const {
   std::ostringstream oss;
   oss << tabS << "------- Fracture --------" << std::endl << std::endl;
   oss << tabS << "Fracture deck address = " << d_fractureDeck_p << std::endl;
-  oss << tabS << "Number of data = " << d_fracture.size() << std::endl;
+  oss << tabS << "Number of data = "
+      << (d_offset.empty() ? 0 : d_offset.size() - 1) << std::endl;
+  oss << tabS << "Number of words = " << d_fracture.size() << std::endl;
   oss << tabS << std::endl;
 
   return oss.str();
@@ -11,7 +11,7 @@
 
 #include "util/point.h" // definition of Point3
 #include <inp/decks/fractureDeck.h>
-#include <stdint.h> // uint8_t type
+#include <stdint.h> // uint64_t type
 #include <string.h> // size_t type
 #include <vector>
 
@@ -21,12 +21,19 @@ struct EdgeCrack;
 struct FractureDeck;
 } // namespace inp
 
+namespace util {
+class PointGrid;
+} // namespace util
+
 /*! @brief Collection of methods and data related to geometry */
 namespace geometry {
 
 /*! @brief A class for fracture state of bonds
  *
- * This class provides method to read and modify fracture state of bonds
+ * This class provides method to read and modify fracture state of bonds.
+ * States of all bonds are stored in one bitset of 64-bit words. Bonds of each
+ * node start at new word so that nodes can modify the state of their bonds
+ * in parallel.
  */
 class Fracture {
 
@@ -46,6 +53,17 @@ public:
    */
   explicit Fracture(inp::FractureDeck *deck);
 
+  /*!
+   * @brief Constructor which copies fracture state of bonds from other object
+   *
+   * Activation of cracks is tracked in the given deck so that objects
+   * sharing the initial fracture state can add cracks independently.
+   *
+   * @param fracture Fracture object to copy
+   * @param deck Input deck which contains user-specified information
+   */
+  Fracture(const Fracture &fracture, inp::FractureDeck *deck);
+
   /*!
    * @brief Sets fracture state according to the crack data
    * @param time Actual simulation time
@@ -78,9 +96,17 @@ public:
    * @brief Returns the list of bonds of node i
    *
    * @param i Nodal id
-   * @return list Bonds of node i
+   * @return list Words storing the state of bonds of node i
+   */
+  std::vector<uint64_t> getBonds(const size_t &i) const;
+
+  /*!
+   * @brief Returns the number of fractured bonds of node i
+   *
+   * @param i Nodal id
+   * @return n Number of fractured bonds
    */
-  std::vector<uint8_t> getBonds(const size_t &i) const;
+  size_t getNumFracturedBonds(const size_t &i) const;
 
   /*!
    * @brief Returns the string containing information about the instance of
@@ -103,6 +129,23 @@ public:
   void print(int nt = 0, int lvl = 0) const { std::cout << printStr(nt, lvl); };
 
 private:
+  /*!
+   * @brief Sets state of bonds which intersect the pre-crack line as
+   * fractured
+   *
+   * Only nodes within distance d_searchRadius of the crack line can have
+   * bonds which intersect the crack. These are found using spatial grid
+   * (grid is empty if there are no bonds).
+   *
+   * @param crack Pointer to the pre-crack
+   * @param grid Spatial grid of nodes
+   * @param nodes Pointer to nodal coordinates
+   * @param neighbor_list Pointer to neighbor list
+   */
+  void applyCrack(inp::EdgeCrack *crack, const util::PointGrid &grid,
+                  const std::vector<util::Point3> *nodes,
+                  const std::vector<std::vector<size_t>> *neighbor_list);
+
   /*!
    * @brief Sets state of bond which intersect the pre-crack line as fractured
    *
@@ -120,12 +163,20 @@ private:
 
   /*! @brief Vector which stores the state of bonds
    *
-   * Given node i, vector d_fracture[i] is the list of state of bonds of node
-   * i.
+   * State of bond j of node i is the bit j % 64 of word
+   * d_fracture[d_offset[i] + j / 64].
    *
    * We only use 1 bit per bond of node to store the state.
    */
-  std::vector<std::vector<uint8_t>> d_fracture;
+  std::vector<uint64_t> d_fracture;
+
+  /*! @brief Offset of first word of bonds of each node (size is number of
+   * nodes + 1) */
+  std::vector<size_t> d_offset;
+
+  /*! @brief Maximum length of bonds (nodes farther than this from crack line
+   * do not have bonds intersecting the crack) */
+  double d_searchRadius;
 };
 
 } // namespace geometry
@@ -10,6 +10,7 @@
 #include "inp/decks/interiorFlagsDeck.h"
 #include "util/compare.h"
 #include "util/utilGeom.h"
+#include <hpx/include/parallel_algorithm.hpp>
 #include <iostream>
 #include "util/utilIO.h"
 
@@ -22,40 +23,31 @@ geometry::BaseInterior::BaseInterior(
     std::vector<std::pair<std::string, std::vector<double>>> no_fail_regions)
     : d_noFailTol(deck->d_noFailTol),
       d_bbox(std::move(bbox)),
-      d_noFailRegions(no_fail_regions) {}
+      d_noFailRegions(no_fail_regions) {
+
+  // resolve type of regions so that strings are not compared for each node
+  for (const auto &data : d_noFailRegions) {
+    if (data.first == "Circle")
+      d_noFailRegionTypes.push_back(geometry::no_fail_circle);
+    else if (data.first == "Rectangle")
+      d_noFailRegionTypes.push_back(geometry::no_fail_rectangle);
+    else
+      d_noFailRegionTypes.push_back(geometry::no_fail_unknown);
+  }
+}
 
 bool geometry::BaseInterior::getInteriorFlag(const size_t &i,
                                              const util::Point3 &x) {
   return true;
 }
 
-std::string geometry::BaseInterior::printStr(int nt, int lvl) const {
-  auto tabS = util::io::getTabS(nt);
-  std::ostringstream oss;
-  oss << tabS << "------- BaseInterior --------" << std::endl << std::endl;
-  oss << tabS << "Number of interior flags = " << d_intFlags.size()
-      << std::endl;
-  oss << tabS << "Bounding box = " << util::io::printBoxStr(d_bbox)
-      << std::endl;
-  oss << tabS << "Number of no-fail region = " << d_noFailRegions.size()
-      << std::endl;
-  oss << tabS << "No-fail region tol = " << d_noFailTol << std::endl;
-  oss << tabS << std::endl;
-
-  return oss.str();
+const std::vector<uint64_t> *geometry::BaseInterior::getInteriorFlagsP()
+    const {
+  return d_intFlags.empty() ? nullptr : &d_intFlags;
 }
 
-//
-// ComputeInterior
-//
-geometry::ComputeInterior::ComputeInterior(
-    inp::InteriorFlagsDeck *deck,
-    std::pair<std::vector<double>, std::vector<double>> bbox,
-    std::vector<std::pair<std::string, std::vector<double>>> no_fail_regions)
-    : geometry::BaseInterior(deck, std::move(bbox), no_fail_regions) {}
-
-bool geometry::ComputeInterior::getInteriorFlag(const size_t &i,
-                                                const util::Point3 &x) {
+bool geometry::BaseInterior::computeInteriorFlag(
+    const util::Point3 &x) const {
   // check for boundary of domain
   {
     // check if x coordinate is on left side of the left interior boundary
@@ -79,19 +71,18 @@ bool geometry::ComputeInterior::getInteriorFlag(const size_t &i,
   }
 
   // check for regions provided
-  for (const auto &data : d_noFailRegions) {
-    if (data.first == "Circle") {
-      auto center =
-          util::Point3(data.second[0], data.second[1], data.second[2]);
-      auto r = data.second[3];
+  for (size_t k = 0; k < d_noFailRegions.size(); k++) {
+    const auto &data = d_noFailRegions[k].second;
+    if (d_noFailRegionTypes[k] == geometry::no_fail_circle) {
+      auto center = util::Point3(data[0], data[1], data[2]);
+      auto r = data[3];
 
       if (util::compare::definitelyLessThan(center.dist(x), r))
         return false;  // want to not fail point x
 
-    } else if (data.first == "Rectangle") {
-      if (util::geometry::isPointInsideRectangle(x, data.second[0],
-                                                 data.second[2], data.second[1],
-                                                 data.second[3]))
+    } else if (d_noFailRegionTypes[k] == geometry::no_fail_rectangle) {
+      if (util::geometry::isPointInsideRectangle(x, data[0], data[2], data[1],
+                                                 data[3]))
         return false;  // want to not fail point x
     }
   }
@@ -99,6 +90,36 @@ bool geometry::ComputeInterior::getInteriorFlag(const size_t &i,
   return true;
 }
 
+std::string geometry::BaseInterior::printStr(int nt, int lvl) const {
+  auto tabS = util::io::getTabS(nt);
+  std::ostringstream oss;
+  oss << tabS << "------- BaseInterior --------" << std::endl << std::endl;
+  oss << tabS << "Number of interior flags = " << d_intFlags.size()
+      << std::endl;
+  oss << tabS << "Bounding box = " << util::io::printBoxStr(d_bbox)
+      << std::endl;
+  oss << tabS << "Number of no-fail region = " << d_noFailRegions.size()
+      << std::endl;
+  oss << tabS << "No-fail region tol = " << d_noFailTol << std::endl;
+  oss << tabS << std::endl;
+
+  return oss.str();
+}
+
+//
+// ComputeInterior
+//
+geometry::ComputeInterior::ComputeInterior(
+    inp::InteriorFlagsDeck *deck,
+    std::pair<std::vector<double>, std::vector<double>> bbox,
+    std::vector<std::pair<std::string, std::vector<double>>> no_fail_regions)
+    : geometry::BaseInterior(deck, std::move(bbox), no_fail_regions) {}
+
+bool geometry::ComputeInterior::getInteriorFlag(const size_t &i,
+                                                const util::Point3 &x) {
+  return computeInteriorFlag(x);
+}
+
 std::string geometry::ComputeInterior::printStr(int nt, int lvl) const {
   auto tabS = util::io::getTabS(nt);
   std::ostringstream oss;
@@ -123,71 +144,25 @@ geometry::DataInterior::DataInterior(
     std::pair<std::vector<double>, std::vector<double>> bbox,
     std::vector<std::pair<std::string, std::vector<double>>> no_fail_regions)
     : geometry::BaseInterior(deck, std::move(bbox), no_fail_regions) {
-  size_t s = nodes->size() / 8;
-  if (s * 8 < nodes->size()) s++;
-  d_intFlags = std::vector<uint8_t>(s, uint8_t(0));
-  for (size_t i = 0; i < nodes->size(); i++) {
-    bool flag = true;
-    auto x = (*nodes)[i];
-
-    // check for boundary of domain
-    {
-      // check if x coordinate is on left side of the left interior boundary
-      if (util::compare::definitelyLessThan(x.d_x,
-                                            d_bbox.first[0] + d_noFailTol))
-        flag = false;
-
-      // check if y coordinate is below the bottom interior boundary
-      if (util::compare::definitelyLessThan(x.d_y,
-                                            d_bbox.first[1] + d_noFailTol))
-        flag = false;
-
-      // check if x coordinate is on right side of the right interior
-      // boundary
-      if (util::compare::definitelyGreaterThan(x.d_x,
-                                               d_bbox.second[0] - d_noFailTol))
-        flag = false;
-
-      // check if y coordinate is on top of the top interior boundary
-      if (util::compare::definitelyGreaterThan(x.d_y,
-                                               d_bbox.second[1] - d_noFailTol))
-        flag = false;
-    }
-
-    // check for regions provided
-    for (const auto &data : d_noFailRegions) {
-      if (data.first == "Circle") {
-        auto center =
-            util::Point3(data.second[0], data.second[1], data.second[2]);
-        auto r = data.second[3];
-
-        if (util::compare::definitelyLessThan(center.dist(x), r))
-          flag = false;  // want to not fail point x
-
-      } else if (data.first == "Rectangle") {
-        if (util::geometry::isPointInsideRectangle(
-                x, data.second[0], data.second[2], data.second[1],
-                data.second[3]))
-          flag = false;  // want to not fail point x
-      }
-    }
-
-    // set loc_bit = i%8 of loc_i = i/8 to flag
-
-    // to set i^th bit as true of integer a,
-    // a |= 1UL << (i % 8)
-
-    // to set i^th bit as flase of integer a,
-    // a &= ~(1UL << (i % 8))
-    flag ? (d_intFlags[i / 8] |= 1UL << (i % 8))
-         : (d_intFlags[i / 8] &= ~(1UL << (i % 8)));
-  }
+  d_intFlags = std::vector<uint64_t>((nodes->size() + 63) / 64, uint64_t(0));
+
+  // each task computes flags of 64 nodes stored in one word
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      d_intFlags.size(), [this, nodes](boost::uint64_t w) {
+        uint64_t word = 0;
+        for (size_t b = 0; b < 64 && 64 * w + b < nodes->size(); b++)
+          if (computeInteriorFlag((*nodes)[64 * w + b]))
+            word |= uint64_t(1) << b;
+
+        d_intFlags[w] = word;
+      });  // end of parallel for loop
+  f.get();
 }
 
 bool geometry::DataInterior::getInteriorFlag(const size_t &i,
                                              const util::Point3 &x) {
-  auto bond = d_intFlags[i / 8];
-  return bond >> (i % 8) & 1UL;
+  return d_intFlags[i / 64] >> (i % 64) & uint64_t(1);
 }
 
 std::string geometry::DataInterior::printStr(int nt, int lvl) const {
@@ -212,7 +187,8 @@ std::string geometry::DataInterior::printStr(int nt, int lvl) const {
 
 geometry::InteriorFlags::InteriorFlags(
     inp::InteriorFlagsDeck *deck, const std::vector<util::Point3> *nodes,
-    const std::pair<std::vector<double>, std::vector<double>> &bbox) {
+    const std::pair<std::vector<double>, std::vector<double>> &bbox)
+    : d_noFailActive(deck->d_noFailActive), d_intFlags_p(nullptr) {
   if (deck->d_noFailActive) {
     if (deck->d_computeAndNotStoreFlag)
       d_interior_p =
@@ -223,10 +199,16 @@ geometry::InteriorFlags::InteriorFlags(
   } else
     d_interior_p =
         new geometry::BaseInterior(deck, bbox, deck->d_noFailRegions);
+
+  d_intFlags_p = d_interior_p->getInteriorFlagsP();
 }
 
 bool geometry::InteriorFlags::getInteriorFlag(const size_t &i,
                                               const util::Point3 &x) {
+  if (!d_noFailActive) return true;
+
+  if (d_intFlags_p) return (*d_intFlags_p)[i / 64] >> (i % 64) & uint64_t(1);
+
   return d_interior_p->getInteriorFlag(i, x);
 }
 
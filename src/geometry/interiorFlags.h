@@ -10,6 +10,7 @@
 #define GEOM_INTERIORFLAGS_H
 
 #include "util/point.h"           // definition of Point3
+#include <stdint.h>               // uint64_t type
 #include <string>
 #include <vector>
 
@@ -20,6 +21,18 @@ struct InteriorFlagsDeck;
 
 namespace geometry {
 
+/*! @brief Types of no-fail regions */
+enum NoFailRegionType {
+  /*! @brief Circle with center (x, y, z) and radius r */
+  no_fail_circle = 0,
+
+  /*! @brief Rectangle with corners (x1, y1) and (x2, y2) */
+  no_fail_rectangle,
+
+  /*! @brief Region which is not supported (ignored) */
+  no_fail_unknown
+};
+
 /*! @brief An abstraction class to store interior/exterior flags of node
  *
  * This is a default class and is used when *no-fail* region is not specified.
@@ -69,12 +82,26 @@ public:
    * */
   void print(int nt = 0, int lvl = 0) const { std::cout << printStr(nt, lvl); };
 
+  /*!
+   * @brief Returns pointer to the stored interior flags
+   * @return Pointer Pointer to flags (nullptr if flags are not stored)
+   */
+  const std::vector<uint64_t> *getInteriorFlagsP() const;
+
 protected:
   /*!
-   * @brief Interior flags. For given node i the flag is d_intFlags[i%8]. We
-   * use 1 bit per node.
+   * @brief Computes interior flag of point from the boundary of domain and
+   * no-fail regions
+   * @param x Nodal coordinate
+   * @return True/False If node is in interior or exterior
    */
-  std::vector<uint8_t> d_intFlags;
+  bool computeInteriorFlag(const util::Point3 &x) const;
+
+  /*!
+   * @brief Interior flags. For given node i the flag is bit i % 64 of
+   * d_intFlags[i / 64]. We use 1 bit per node.
+   */
+  std::vector<uint64_t> d_intFlags;
 
   /*! @brief Bounding box */
   std::pair<std::vector<double>, std::vector<double>> d_bbox;
@@ -82,6 +109,9 @@ protected:
   /*! @brief Specify multiple regions in which we set no-fail flag to true */
   std::vector<std::pair<std::string, std::vector<double>>> d_noFailRegions;
 
+  /*! @brief Types of no-fail regions */
+  std::vector<NoFailRegionType> d_noFailRegionTypes;
+
   /*! @brief Tolerance to check if the point is in interior/exterior */
   double d_noFailTol;
 };
@@ -210,7 +240,10 @@ public:
       const std::pair<std::vector<double>, std::vector<double>> &bbox);
 
   /*!
-   * @brief Returns true for all the nodes
+   * @brief Returns true if node is in interior
+   *
+   * If flags are stored, this is a single bit test.
+   *
    * @param i Nodal id
    * @param x Nodal coordinate
    * @return Flag True if node is in interior otherwise false
@@ -240,6 +273,12 @@ public:
 private:
   /*! @brief Class providing interior flags and method */
   BaseInterior *d_interior_p;
+
+  /*! @brief Flag which indicates if no-fail region is active */
+  bool d_noFailActive;
+
+  /*! @brief Pointer to stored interior flags (nullptr if not stored) */
+  const std::vector<uint64_t> *d_intFlags_p;
 };
 
 } // namespace geometry
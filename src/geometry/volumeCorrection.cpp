@@ -10,6 +10,7 @@
 
 #include <hpx/include/parallel_algorithm.hpp>
 
+#include "inp/policy.h"
 #include "util/compare.h"
 #include "util/utilIO.h"
 
@@ -26,6 +27,7 @@ void geometry::VolumeCorrection::correctVolume(
     const double &horizon, const double &dx, geometry::Neighbor *neighbors,
     const std::vector<util::Point3> *nodes) {
   d_volumeCorrection_p = new std::vector<std::vector<double>>(nodes->size());
+  d_volumeCorrectionF_p = nullptr;
 
   hpx::parallel::for_loop(
       hpx::parallel::execution::par, 0, nodes->size(), [&](boost::uint64_t i) {
@@ -43,6 +45,27 @@ void geometry::VolumeCorrection::correctVolume(
           k++;
         }
       });
+
+  // check if we store the bond data in single precision
+  if (nodes->empty() ||
+      inp::Policy::getInstance()->populateData("Bond_d_double"))
+    return;
+
+  std::cout << "VolumeCorrection: Storing volume correction in single "
+               "precision.\n";
+  d_volumeCorrectionF_p = new std::vector<std::vector<float>>(nodes->size());
+
+  hpx::parallel::for_loop(
+      hpx::parallel::execution::par, 0, nodes->size(), [&](boost::uint64_t i) {
+        const auto &vc = (*d_volumeCorrection_p)[i];
+        (*d_volumeCorrectionF_p)[i] = std::vector<float>(vc.begin(), vc.end());
+
+        // free double precision data
+        std::vector<double>().swap((*d_volumeCorrection_p)[i]);
+      });
+
+  delete d_volumeCorrection_p;
+  d_volumeCorrection_p = nullptr;
 }
 
 void geometry::VolumeCorrection::weightedVolume(
@@ -57,7 +80,7 @@ void geometry::VolumeCorrection::weightedVolume(
 
         for (auto j : neighbors->getNeighbors(i)) {
           util::Point3 X = (*nodes)[j] - (*nodes)[i];
-          tmp += (X.length() * X.length() * (*d_volumeCorrection_p)[i][k] *
+          tmp += (X.length() * X.length() * getVolumeCorrection(i, k) *
                   p_mesh->getNodalVolume(j));
           k++;
         }
@@ -47,15 +47,39 @@ public:
 
 	/*! @brief Weighted volume of nodes */
 	std::vector<double>* d_weightedVolume_p;
-	/*! @brief Volume correction for the neighborhood of each node */
+	/*!
+	 * @brief Volume correction for the neighborhood of each node
+	 *
+	 * This is nullptr if volume correction is stored in single precision.
+	 */
 	std::vector<std::vector<double>>* d_volumeCorrection_p;
 
+	/*!
+	 * @brief Volume correction for the neighborhood of each node in single
+	 * precision
+	 *
+	 * Used instead of d_volumeCorrection_p if policy disables double
+	 * precision storage of bond data (tag Bond_d_double), otherwise nullptr.
+	 */
+	std::vector<std::vector<float>>* d_volumeCorrectionF_p;
+
 	/*!
 	 * @brief Constructor
 	 * @param dataManager Pointer to the data manager object
 	 */
 	VolumeCorrection(data::DataManager* dataManager);
 
+	/*!
+	 * @brief Returns the volume correction of bond
+	 * @param i Id of node
+	 * @param k Local id of neighbor in neighbor list of node i
+	 * @return correction Volume correction
+	 */
+	double getVolumeCorrection(const size_t &i, const size_t &k) const {
+		return d_volumeCorrectionF_p ? double((*d_volumeCorrectionF_p)[i][k])
+		                             : (*d_volumeCorrection_p)[i][k];
+	};
+
   /*!
 * @brief Returns the string containing information about the instance of
 * the object
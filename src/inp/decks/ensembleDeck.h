@@ -0,0 +1,148 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef INP_ENSEMBLEDECK_H
+#define INP_ENSEMBLEDECK_H
+
+#include "util/utilIO.h"
+#include <string>
+#include <vector>
+
+namespace inp {
+
+/**
+ * \ingroup Input
+ */
+/**@{*/
+
+/*! @brief Structure to store overrides of one member of ensemble
+ *
+ * Negative value means the value in input file is used.
+ */
+struct EnsembleMember {
+
+  /*! @brief Tag of member (output files are prefixed by tag) */
+  std::string d_tag;
+
+  /*! @brief Young's modulus */
+  double d_E;
+
+  /*! @brief Bulk modulus */
+  double d_K;
+
+  /*! @brief Critical energy release rate */
+  double d_Gc;
+
+  /*! @brief Critical stress intensity factor */
+  double d_KIc;
+
+  /*! @brief Density */
+  double d_density;
+
+  /*! @brief Factor multiplying the horizon in input file */
+  double d_horizonFactor;
+
+  /*!
+   * @brief Constructor
+   */
+  EnsembleMember()
+      : d_E(-1.), d_K(-1.), d_Gc(-1.), d_KIc(-1.), d_density(-1.),
+        d_horizonFactor(-1.){};
+
+  /*!
+   * @brief Returns the string containing information about the instance of
+   * the object
+   *
+   * @param nt Number of tabs to append before each line of string
+   * @param lvl Level of information sought (higher level means more
+   * information)
+   * @return string String containing information about this object
+   * */
+  std::string printStr(int nt = 0, int lvl = 0) const {
+    auto tabS = util::io::getTabS(nt);
+    std::ostringstream oss;
+    oss << tabS << "------- EnsembleMember --------" << std::endl << std::endl;
+    oss << tabS << "Tag = " << d_tag << std::endl;
+    oss << tabS << "Young's modulus = " << d_E << std::endl;
+    oss << tabS << "Bulk modulus = " << d_K << std::endl;
+    oss << tabS << "Critical energy release rate = " << d_Gc << std::endl;
+    oss << tabS << "Critical stress intensity factor = " << d_KIc
+        << std::endl;
+    oss << tabS << "Density = " << d_density << std::endl;
+    oss << tabS << "Horizon factor = " << d_horizonFactor << std::endl;
+    oss << tabS << std::endl;
+
+    return oss.str();
+  };
+
+  /*!
+   * @brief Prints the information about the instance of the object
+   *
+   * @param nt Number of tabs to append before each line of string
+   * @param lvl Level of information sought (higher level means more
+   * information)
+   * */
+  void print(int nt = 0, int lvl = 0) const { std::cout << printStr(nt, lvl); };
+};
+
+/*! @brief Structure to read and store ensemble (parameter sweep) data
+ *
+ * If members are specified, simulation of input file is performed once for
+ * each member with the material data overridden by the member. Mesh,
+ * neighbor list and fracture data are created once and shared by members.
+ */
+struct EnsembleDeck {
+
+  /*! @brief List of members */
+  std::vector<inp::EnsembleMember> d_members;
+
+  /*! @brief Maximum number of members simulated concurrently */
+  size_t d_maxConcurrent;
+
+  /*!
+   * @brief Constructor
+   */
+  EnsembleDeck() : d_maxConcurrent(4){};
+
+  /*!
+   * @brief Returns the string containing information about the instance of
+   * the object
+   *
+   * @param nt Number of tabs to append before each line of string
+   * @param lvl Level of information sought (higher level means more
+   * information)
+   * @return string String containing information about this object
+   * */
+  std::string printStr(int nt = 0, int lvl = 0) const {
+    auto tabS = util::io::getTabS(nt);
+    std::ostringstream oss;
+    oss << tabS << "------- EnsembleDeck --------" << std::endl << std::endl;
+    oss << tabS << "Number of members = " << d_members.size() << std::endl;
+    oss << tabS << "Maximum concurrent members = " << d_maxConcurrent
+        << std::endl;
+    for (const auto &m : d_members) oss << m.printStr(nt + 1, lvl);
+    oss << tabS << std::endl;
+
+    return oss.str();
+  };
+
+  /*!
+   * @brief Prints the information about the instance of the object
+   *
+   * @param nt Number of tabs to append before each line of string
+   * @param lvl Level of information sought (higher level means more
+   * information)
+   * */
+  void print(int nt = 0, int lvl = 0) const { std::cout << printStr(nt, lvl); };
+};
+
+/** @}*/
+
+} // namespace inp
+
+#endif // INP_ENSEMBLEDECK_H
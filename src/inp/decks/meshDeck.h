@@ -55,6 +55,16 @@ struct MeshDeck {
    */
   bool d_keepElementConn;
 
+  /*!
+   * @brief Space filling curve used to reorder nodes
+   *
+   * List of allowed values are:
+   * - empty (nodes are not reordered)
+   * - \a morton
+   * - \a hilbert
+   */
+  std::string d_reorderNodes;
+
   /*!
    * @brief Constructor
    */
@@ -82,6 +92,7 @@ struct MeshDeck {
     oss << tabS << "Mesh size = " << d_h << std::endl;
     oss << tabS << "Is this centroid-based particle mesh = " << d_isCentroidBasedDiscretization <<
         std::endl;
+    oss << tabS << "Reorder nodes = " << d_reorderNodes << std::endl;
     oss << tabS << std::endl;
 
     return oss.str();
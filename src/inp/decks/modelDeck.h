@@ -80,12 +80,27 @@ struct ModelDeck {
   /*! @brief Mesh size */
   double d_h;
 
+  /*!
+   * @brief Flag which indicates if each bond is evaluated only once
+   *
+   * If true, bond-based forces are computed once for each pair of nodes and
+   * added to both nodes of the bond.
+   */
+  bool d_halfBond;
+
+  /*!
+   * @brief Number of time steps between removal of broken bonds from list of
+   * active bonds (zero means all bonds are evaluated in every time step)
+   */
+  size_t d_bondCompactionInterval;
+
   /*!
    * @brief Constructor
    */
   ModelDeck()
       : d_dim(0), d_isRestartActive(false), d_tFinal(0.), d_dt(0.), d_Nt(0),
-        d_horizon(0.), d_rh(0), d_h(0.){};
+        d_horizon(0.), d_rh(0), d_h(0.), d_halfBond(false),
+        d_bondCompactionInterval(0){};
 
   /*!
    * @brief Returns the string containing information about the instance of
@@ -110,6 +125,9 @@ struct ModelDeck {
     oss << tabS << "Size time steps = " << d_dt << std::endl;
     oss << tabS << "Mesh size = " << d_h << std::endl;
     oss << tabS << "Horizon = " << d_horizon << std::endl;
+    oss << tabS << "Half bond evaluation = " << d_halfBond << std::endl;
+    oss << tabS << "Bond compaction interval = " << d_bondCompactionInterval
+        << std::endl;
     oss << tabS << std::endl;
 
     return oss.str();
@@ -23,9 +23,12 @@ namespace inp {
 /*! @brief Structure to read input data for performing simulation output */
 struct OutputDeck {
 
-  /*! @brief Output format: currently supports vtu, msh, legacy_vtk output
+  /*! @brief Output format: currently supports vtu, msh, legacy_vtk and hdf5
+   * output
    *
-   * Default is vtu format.
+   * Default is vtu format. With hdf5, all output steps are written to a
+   * single output.h5 file with output.xmf descriptor (requires build with
+   * Enable_HDF5).
    */
   std::string d_outFormat;
 
@@ -55,9 +58,23 @@ struct OutputDeck {
    */
   bool d_performFEOut;
 
-  /*! @brief Compressor type for .vtu files */
+  /*! @brief Compressor type for output files
+   *
+   * For .vtu files "zlib" is supported. For .msh files "binary" writes
+   * binary file and "zlib" writes binary file compressed with zlib.
+   */
   std::string d_compressType;
 
+  /*!
+   * @brief Number of pieces the output is split into
+   *
+   * If more than one, for vtu output each piece is written in parallel to its
+   * own .vtu file and a .pvtu file listing the pieces is created. Since
+   * restart and the tools read single .vtu files, this is meant for
+   * visualization only.
+   */
+  size_t d_numPieces;
+
   /*! @brief Specify output criteria to change output frequency
    *
    * Choices are:
@@ -79,12 +96,28 @@ struct OutputDeck {
   /*! @brief List of parameters required in checking output criteria */
   std::vector<double> d_outCriteriaParams;
 
+  /*! @brief Size of time steps (or frequency) for in-situ analysis
+   *
+   * If zero (default), in-situ analysis is not performed. See
+   * model::InSitu.
+   */
+  size_t d_inSituDt;
+
+  /*! @brief List of tags of quantities computed in in-situ analysis
+   *
+   * Choices are:
+   * - Crack_Tip
+   * - Strain
+   */
+  std::vector<std::string> d_inSituTags;
+
   /*!
    * @brief Constructor
    */
   OutputDeck()
       : d_outFormat("vtu"), d_path("./"), d_dtOut(0), d_dtOutOld(0), d_debug(0),
-        d_performFEOut(true), d_dtOutCriteria(0){};
+        d_performFEOut(true), d_numPieces(1), d_dtOutCriteria(0),
+        d_inSituDt(0){};
 
   /*!
    * @brief Searches list of tags and returns true if the asked tag is in the
@@ -119,6 +152,12 @@ struct OutputDeck {
     oss << tabS << "Output path = " << d_path << std::endl;
     oss << tabS << "Output tags = " << util::io::printStr(d_outTags) << std::endl;
     oss << tabS << "Output interval = " << d_dtOut << std::endl;
+    oss << tabS << "Number of output pieces = " << d_numPieces << std::endl;
+    if (d_inSituDt > 0) {
+      oss << tabS << "In-situ analysis interval = " << d_inSituDt << std::endl;
+      oss << tabS << "In-situ analysis tags = "
+          << util::io::printStr(d_inSituTags) << std::endl;
+    }
     oss << tabS << "Debug level = " << d_debug << std::endl;
     oss << tabS << std::endl;
 
@@ -24,8 +24,11 @@ struct PolicyDeck {
   /*!
    * @brief Flag which indicates level of memory control to be enforced
    *
-   * Default is 0 which means no control. Max at present is 2 which means as
-   * much control as possible.
+   * Default is 0 which means no control. Max at present is 3 which means as
+   * much control as possible. From level 2 onwards, per-bond static data
+   * such as volume correction is stored in single precision. Only models
+   * which store the volume correction (state-based models) save memory; the
+   * bond-based finite difference model (RNPBond) is not affected.
    */
   int d_memControlFlag;
 
@@ -14,6 +14,7 @@
 #include <cmath>
 #include <iostream>
 
+#include "decks/ensembleDeck.h"
 #include "decks/fractureDeck.h"
 #include "decks/initialConditionDeck.h"
 #include "decks/interiorFlagsDeck.h"
@@ -50,7 +51,12 @@ inp::Input::Input(const std::string &filename)
       d_outputDeck_p(nullptr),
       d_policyDeck_p(nullptr),
       d_modelDeck_p(nullptr),
-      d_solverDeck_p(nullptr) {
+      d_solverDeck_p(nullptr),
+      d_massMatrixDeck_p(nullptr),
+      d_quadratureDeck_p(nullptr),
+      d_restartDeck_p(nullptr),
+      d_absorbingCondDeck_p(nullptr),
+      d_ensembleDeck_p(nullptr) {
   d_inputFilename = filename;
 
   // follow the order of reading
@@ -69,6 +75,26 @@ inp::Input::Input(const std::string &filename)
   setPolicyDeck();
   setSolverDeck();
   setAbsorbingCondDeck();
+  setEnsembleDeck();
+}
+
+inp::Input::~Input() {
+  delete d_fractureDeck_p;
+  delete d_meshDeck_p;
+  delete d_initialConditionDeck_p;
+  delete d_interiorFlagsDeck_p;
+  delete d_loadingDeck_p;
+  delete d_massMatrixDeck_p;
+  delete d_materialDeck_p;
+  delete d_modelDeck_p;
+  delete d_neighborDeck_p;
+  delete d_outputDeck_p;
+  delete d_policyDeck_p;
+  delete d_quadratureDeck_p;
+  delete d_restartDeck_p;
+  delete d_solverDeck_p;
+  delete d_absorbingCondDeck_p;
+  delete d_ensembleDeck_p;
 }
 
 //
@@ -114,6 +140,8 @@ inp::AbsorbingCondDeck *inp::Input::getAbsorbingCondDeck() {
   return d_absorbingCondDeck_p;
 }
 
+inp::EnsembleDeck *inp::Input::getEnsembleDeck() { return d_ensembleDeck_p; }
+
 const std::string inp::Input::getSpatialDiscretization() {
   return d_modelDeck_p->d_spatialDiscretization;
 }
@@ -183,6 +211,14 @@ void inp::Input::setModelDeck() {
 
   d_modelDeck_p->d_dt = d_modelDeck_p->d_tFinal / d_modelDeck_p->d_Nt;
 
+  // check if bonds are to be evaluated once for both nodes
+  if (config["Model"]["Half_Bond"])
+    d_modelDeck_p->d_halfBond = config["Model"]["Half_Bond"].as<bool>();
+
+  if (config["Model"]["Bond_Compaction_Interval"])
+    d_modelDeck_p->d_bondCompactionInterval =
+        config["Model"]["Bond_Compaction_Interval"].as<size_t>();
+
   // check if this is restart problem
   if (config["Restart"]) d_modelDeck_p->d_isRestartActive = true;
 }  // setModelDeck
@@ -246,6 +282,10 @@ void inp::Input::setMeshDeck() {
     d_meshDeck_p->d_keepElementConn =
         config["Mesh"]["Keep_Element_Conn"].as<bool>();
 
+  if (config["Mesh"]["Reorder_Nodes"])
+    d_meshDeck_p->d_reorderNodes =
+        config["Mesh"]["Reorder_Nodes"].as<std::string>();
+
 }  // setMeshDeck
 
 void inp::Input::setMassMatrixDeck() {
@@ -713,6 +753,8 @@ void inp::Input::setOutputDeck() {
       d_outputDeck_p->d_performFEOut = e["Perform_FE_Out"].as<bool>();
     if (e["Compress_Type"])
       d_outputDeck_p->d_compressType = e["Compress_Type"].as<std::string>();
+    if (e["Num_Pieces"])
+      d_outputDeck_p->d_numPieces = e["Num_Pieces"].as<size_t>();
     if (e["Output_Criteria"]) {
       if (e["Output_Criteria"]["Type"])
         d_outputDeck_p->d_outCriteria =
@@ -726,6 +768,13 @@ void inp::Input::setOutputDeck() {
           d_outputDeck_p->d_outCriteriaParams.emplace_back(p.as<double>());
       }
     }
+    if (e["In_Situ"]) {
+      if (e["In_Situ"]["Interval"])
+        d_outputDeck_p->d_inSituDt = e["In_Situ"]["Interval"].as<size_t>();
+      if (e["In_Situ"]["Tags"])
+        for (auto f : e["In_Situ"]["Tags"])
+          d_outputDeck_p->d_inSituTags.push_back(f.as<std::string>());
+    }
   }
 }  // setOutputDeck
 
@@ -899,4 +948,42 @@ std::string inp::Input::printStr(int nt, int lvl) const {
   oss << tabS << std::endl;
 
   return oss.str();
-}
\ No newline at end of file
+}
+
+void inp::Input::setEnsembleDeck() {
+  d_ensembleDeck_p = new inp::EnsembleDeck();
+  YAML::Node config = YAML::LoadFile(d_inputFilename);
+
+  auto e = config["Ensemble"];
+  if (!e) return;
+
+  if (e["Max_Concurrent"])
+    d_ensembleDeck_p->d_maxConcurrent = e["Max_Concurrent"].as<size_t>();
+  if (d_ensembleDeck_p->d_maxConcurrent == 0)
+    d_ensembleDeck_p->d_maxConcurrent = 1;
+
+  if (!e["Members"]) {
+    std::cerr << "Error: Expecting list of members in block "
+                 "Ensemble->Members.\n";
+    exit(1);
+  }
+
+  for (auto m : e["Members"]) {
+    auto member = inp::EnsembleMember();
+    if (m["Tag"])
+      member.d_tag = m["Tag"].as<std::string>();
+    else
+      member.d_tag =
+          "member_" + std::to_string(d_ensembleDeck_p->d_members.size());
+
+    if (m["E"]) member.d_E = m["E"].as<double>();
+    if (m["K"]) member.d_K = m["K"].as<double>();
+    if (m["Gc"]) member.d_Gc = m["Gc"].as<double>();
+    if (m["KIc"]) member.d_KIc = m["KIc"].as<double>();
+    if (m["Density"]) member.d_density = m["Density"].as<double>();
+    if (m["Horizon_Factor"])
+      member.d_horizonFactor = m["Horizon_Factor"].as<double>();
+
+    d_ensembleDeck_p->d_members.push_back(member);
+  }
+}  // setEnsembleDeck
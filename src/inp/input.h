@@ -46,6 +46,7 @@ struct QuadratureDeck;
 struct RestartDeck;
 struct SolverDeck;
 struct AbsorbingCondDeck;
+struct EnsembleDeck;
 
 /**
  * \defgroup Input Input
@@ -69,6 +70,11 @@ public:
    */
   explicit Input(const std::string &filename);
 
+  /*!
+   * @brief Destructor (deletes all decks)
+   */
+  ~Input();
+
   /**
    * @name Accessor methods
    */
@@ -164,6 +170,12 @@ public:
    */
   inp::AbsorbingCondDeck *getAbsorbingCondDeck();
 
+  /*!
+   * @brief Get the pointer to ensemble deck
+   * @return Pointer to EnsembleDeck
+   */
+  inp::EnsembleDeck *getEnsembleDeck();
+
   /*!
    * @brief Get the name of spatial discretization
    *
@@ -283,6 +295,11 @@ private:
    */
   void setSolverDeck();
 
+  /*!
+   * @brief Read data into ensemble deck and store its pointer
+   */
+  void setEnsembleDeck();
+
   /** @}*/
 
   /**
@@ -407,6 +424,12 @@ private:
    */
   inp::AbsorbingCondDeck *d_absorbingCondDeck_p;
 
+  /*!
+   * @brief Pointer to deck holding list of members of ensemble (parameter
+   * sweep)
+   */
+  inp::EnsembleDeck *d_ensembleDeck_p;
+
   /** @}*/
 };
 
@@ -65,6 +65,10 @@ void inp::Policy::init() {
       d_lTags[2].emplace_back("Model_d_eF");
       d_lTags[2].emplace_back("Model_d_eFB");
 
+      // per-bond static data (e.g. volume correction) is stored in single
+      // precision, forces are still accumulated in double precision
+      d_lTags[2].emplace_back("Bond_d_double");
+
       // level 3 tags
       d_lTags[3] = d_lTags[2];
       d_lTags[3].emplace_back("Model_d_Z");
@@ -134,8 +134,9 @@ private:
   /*!
    * @brief Flag which indicates level of memory control to be enforced
    *
-   * Default is 0 which means no control. Max at present is 2 which means as
-   * much control as possible.
+   * Default is 0 which means no control. Max at present is 3 which means as
+   * much control as possible. From level 2 onwards, per-bond static data
+   * such as volume correction is stored in single precision.
    */
   int d_memControlFlag;
 
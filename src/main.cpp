@@ -13,6 +13,7 @@
 #include <hpx/timing/high_resolution_clock.hpp>
 #include <iostream>
 
+#include "inp/decks/ensembleDeck.h"
 #include "inp/decks/materialDeck.h"
 #include "inp/input.h"  // Input class
 #include "material/materials.h"
@@ -69,7 +70,10 @@ int main(int argc, char *argv[]) {
                deck->getModelDeck()->d_timeDiscretization ==
                    "velocity_verlet") {
       if (deck->getMaterialDeck()->d_materialType == "RNPBond") {
-        model::FDModel<material::pd::RNPBond> fdModel(deck);
+        if (!deck->getEnsembleDeck()->d_members.empty())
+          model::Ensemble ensemble(filename);
+        else
+          model::FDModel<material::pd::RNPBond> fdModel(deck);
       }
 
     }
@@ -81,6 +85,8 @@ int main(int argc, char *argv[]) {
     }
   }
 
+  delete deck;
+
   // get time elapsed
   std::uint64_t end = hpx::util::high_resolution_clock::now();
   double elapsed_secs = double(end - begin) / 1.0e9;
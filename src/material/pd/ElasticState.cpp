@@ -252,21 +252,21 @@ std::pair<util::Point3, double> material::pd::ElasticState::getBondEF(
 
       strainE = 0.5 * alpha * w * (*d_dataManager_p->getExtensionP())[i][j] *
                 (*d_dataManager_p->getExtensionP())[i][j] *
-                (*d_dataManager_p->getVolumeCorrectionP()
-                      ->d_volumeCorrection_p)[i][j] *
+                d_dataManager_p->getVolumeCorrectionP()->getVolumeCorrection(
+                    i, j) *
                 (*d_dataManager_p->getMeshP()->getNodalVolumesP())[j_id];
 
     else
 
       strainE = 0.5 * w * (alpha_s * e_s * e_s + alpha_d * e_d * e_d) *
-                (*d_dataManager_p->getVolumeCorrectionP()
-                      ->d_volumeCorrection_p)[i][j] *
+                d_dataManager_p->getVolumeCorrectionP()->getVolumeCorrection(
+                    i, j) *
                 (*d_dataManager_p->getMeshP()->getNodalVolumesP())[j_id];
   }
 
   return std::make_pair<util::Point3, double>(
-      std::move(M * t) * (*d_dataManager_p->getVolumeCorrectionP()
-                               ->d_volumeCorrection_p)[i][j],
+      std::move(M * t) *
+          d_dataManager_p->getVolumeCorrectionP()->getVolumeCorrection(i, j),
       std::move(strainE));
 }
 
@@ -295,7 +295,7 @@ util::Matrix33 material::pd::ElasticState::K_shape_tensor(size_t i) {
 
     K +=
         X.toMatrix() * w *
-        (*d_dataManager_p->getVolumeCorrectionP()->d_volumeCorrection_p)[i][n] *
+        d_dataManager_p->getVolumeCorrectionP()->getVolumeCorrection(i, n) *
         (*d_dataManager_p->getMeshP()->getNodalVolumesP())[j];
   }
   return K;
@@ -313,7 +313,7 @@ util::Matrix33 material::pd::ElasticState::deformation_gradient(size_t i) {
 
     tmp +=
         Y.toMatrix(X) * w *
-        (*d_dataManager_p->getVolumeCorrectionP()->d_volumeCorrection_p)[i][n] *
+        d_dataManager_p->getVolumeCorrectionP()->getVolumeCorrection(i, n) *
         (*d_dataManager_p->getMeshP()->getNodalVolumesP())[j];
 
     n++;
@@ -351,7 +351,7 @@ double material::pd::ElasticState::dirac_delta(util::Point3 x, size_t i,
   if (util::compare::essentiallyEqual(x.length(), 0))
     delta =
         1. / (*d_dataManager_p->getMeshP()->getNodalVolumesP())[j] *
-        (*d_dataManager_p->getVolumeCorrectionP()->d_volumeCorrection_p)[i][m];
+        d_dataManager_p->getVolumeCorrectionP()->getVolumeCorrection(i, m);
 
   return delta;
 }
@@ -442,11 +442,10 @@ util::Matrix33 material::pd::ElasticState::getStress(size_t i) {
     for (auto k : d_dataManager_p->getNeighborP()->getNeighbors(i)) {
       util::Point3 Xk = this->X_vector_state(i, k);
 
-      double volume = (*d_dataManager_p->getVolumeCorrectionP()
-                            ->d_volumeCorrection_p)[i][m] *
+      const auto vc = d_dataManager_p->getVolumeCorrectionP();
+      double volume = vc->getVolumeCorrection(i, m) *
                       (*d_dataManager_p->getMeshP()->getNodalVolumesP())[k] *
-                      (*d_dataManager_p->getVolumeCorrectionP()
-                            ->d_volumeCorrection_p)[i][n] *
+                      vc->getVolumeCorrection(i, n) *
                       (*d_dataManager_p->getMeshP()->getNodalVolumesP())[j];
 
       util::Vector3 res = (this->K_modulus_tensor(i, j, k, m) *
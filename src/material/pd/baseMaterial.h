@@ -60,6 +60,18 @@ public:
 
   };
 
+  /*!
+   * @brief Returns energy of bond without updating the fracture state, so
+   * that it can be called concurrently for the same node
+   *
+   * @param i Id of node 1
+   * @param j Local id in the neighborlist of node i
+   * @return energy Energy of bond
+   */
+  virtual double getBondEnergy(size_t i, size_t j) {
+    return getBondEF(i, j).second;
+  };
+
   /*!
    * @brief Returns the bond strain
    * @param dx Reference bond vector
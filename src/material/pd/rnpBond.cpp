@@ -201,6 +201,15 @@ void material::pd::RNPBond::computeMaterialProperties(inp::MaterialDeck *deck,
 //    const double &r, const double &s, const double &influence, bool &fs) {
 std::pair<util::Point3, double> material::pd::RNPBond::getBondEF(size_t i,
                                                                  size_t j) {
+  return getBondEF(i, j, true);
+}
+
+double material::pd::RNPBond::getBondEnergy(size_t i, size_t j) {
+  return getBondEF(i, j, false).second;
+}
+
+std::pair<util::Point3, double> material::pd::RNPBond::getBondEF(
+    size_t i, size_t j, bool update_state) {
   auto force = util::Point3();
   double energy = 0.;
 
@@ -246,13 +255,14 @@ std::pair<util::Point3, double> material::pd::RNPBond::getBondEF(size_t i,
 
   if (break_bonds) {
     // check if fracture state of the bond need to be updated
+    // and update bond-state only if bond breaks
     if (d_irrevBondBreak && !fs &&
         util::compare::definitelyGreaterThan(std::abs(Sji),
-                                             d_factorSc * getSc(rji)))
+                                             d_factorSc * getSc(rji))) {
       fs = true;
-
-    // update bond-state
-    d_dataManager_p->getFractureP()->setBondState(i, j, fs);
+      if (update_state)
+        d_dataManager_p->getFractureP()->setBondState(i, j, fs);
+    }
 
     // if bond is not fractured, return energy and force from nonlinear
     // potential otherwise return energy of fractured bond, and zero force
@@ -286,6 +296,76 @@ std::pair<util::Point3, double> material::pd::RNPBond::getBondEF(size_t i,
   }
 }
 
+std::pair<util::Point3, util::Point3> material::pd::RNPBond::getBondForces(
+    size_t i, size_t j, bool &fs) {
+  // get global id of j
+  auto j_id = d_dataManager_p->getNeighborP()->getNeighbor(i, j);
+
+  // get fracture state
+  fs = d_dataManager_p->getFractureP()->getBondState(i, j);
+
+  // get location of nodes
+  auto xi = d_dataManager_p->getMeshP()->getNode(i);
+  auto ui = (*d_dataManager_p->getDisplacementP())[i];
+
+  auto xj = d_dataManager_p->getMeshP()->getNode(j_id);
+  auto uj = (*d_dataManager_p->getDisplacementP())[j_id];
+
+  // get interior flags (to enforce no-fail region method)
+  bool break_bonds =
+      d_dataManager_p->getInteriorFlagsP()->getInteriorFlag(i, xi) &&
+      d_dataManager_p->getInteriorFlagsP()->getInteriorFlag(j_id, xj);
+
+  // get distance between nodes and bond-strain
+  auto rji = xj.dist(xi);
+  auto Sji = this->getS(xj - xi, uj - ui);
+  auto eij = this->getBondForceDirection(xj - xi, uj - ui);
+
+  // volume correction is symmetric and is applied to the volume of other node
+  auto h = d_dataManager_p->getMeshP()->getMeshSize();
+  double corr = 1.;
+  if (util::compare::definitelyGreaterThan(rji, d_horizon - 0.5 * h))
+    corr = (d_horizon + 0.5 * h - rji) / h;
+
+  auto voli = d_dataManager_p->getMeshP()->getNodalVolume(i);
+  auto volj = d_dataManager_p->getMeshP()->getNodalVolume(j_id);
+
+  // get influence function
+  auto influence = d_baseInfluenceFn_p->getInfFn(rji / d_horizon);
+
+  double scalar_f = 0.;
+  if (break_bonds) {
+    // check if fracture state of the bond need to be updated
+    // and update bond-state only if bond breaks
+    if (d_irrevBondBreak && !fs &&
+        util::compare::definitelyGreaterThan(std::abs(Sji),
+                                             d_factorSc * getSc(rji))) {
+      fs = true;
+      d_dataManager_p->getFractureP()->setBondState(i, j, fs);
+    }
+
+    if (!fs)
+      scalar_f = influence * 4. * Sji * d_C * d_beta *
+                 std::exp(-d_beta * rji * Sji * Sji) / d_invFactor;
+    else {
+      // normal contact force between nodes of broken bond (harmonic mean of
+      // volumes depends on which volume is corrected)
+      auto yji = xj + uj - (xi + ui);
+      auto Rji = yji.length();
+      auto f = d_contact_Kn * (d_contact_Rc - Rji) / Rji;
+      if (f < 0.) f = 0.;
+
+      auto volj_c = corr * volj;
+      auto voli_c = corr * voli;
+      return {-f * (voli * volj_c / (voli + volj_c)) * yji,
+              f * (volj * voli_c / (volj + voli_c)) * yji};
+    }
+  } else
+    scalar_f = influence * 4. * Sji * d_C * d_beta / d_invFactor;
+
+  return {(scalar_f * corr * volj) * eij, (-scalar_f * corr * voli) * eij};
+}
+
 double material::pd::RNPBond::getS(const util::Point3 &dx,
                                    const util::Point3 &du) {
   return dx.dot(du) / dx.dot(dx);
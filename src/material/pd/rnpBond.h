@@ -100,6 +100,32 @@ public:
 	 */
   std::pair<util::Point3, double> getBondEF(size_t i, size_t j);
 
+  /*!
+   * @brief Returns energy of bond between node i and node j without updating
+   * the fracture state of the bond
+   *
+   * @param i Id of node i
+   * @param j Local id of node j in neighbor list of node i
+   * @return energy Energy of bond
+   */
+  double getBondEnergy(size_t i, size_t j);
+
+  /*!
+   * @brief Returns force on both nodes of bond between node i and node j
+   *
+   * Bond is evaluated once. Force on node j is same as the force returned by
+   * getBondEF when called from node j, i.e. it differs from the force on
+   * node i only in sign and the volume factor. Fracture state of the bond is
+   * updated only in the neighbor list of node i.
+   *
+   * @param i Id of node i
+   * @param j Local id of node j in neighbor list of node i
+   * @param fs Fracture state of bond after update
+   * @return forces Pair of force on node i and force on node j
+   */
+  std::pair<util::Point3, util::Point3> getBondForces(size_t i, size_t j,
+                                                      bool &fs);
+
   /*!
    * @brief Returns the bond strain
    * @param dx Reference bond vector
@@ -150,6 +176,17 @@ public:
   double getInfFn(const double &r) const ;
 
 private:
+  /*!
+   * @brief Returns energy and force state between node i and node j
+   * @param i Id of node i
+   * @param j Local id of node j in neighbor list of node i
+   * @param update_state Mark the bond as broken in fracture data if it
+   * breaks
+   * @return Value Pair of energy and force
+   */
+  std::pair<util::Point3, double> getBondEF(size_t i, size_t j,
+                                            bool update_state);
+
   /*!
    * @brief Computes rnp material parameters from elastic constants
    *
@@ -0,0 +1,159 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "ensemble.h"
+
+#include "data/DataManager.h"
+#include "fe/mesh.h"
+#include "geometry/fracture.h"
+#include "geometry/interiorFlags.h"
+#include "geometry/neighbor.h"
+#include "inp/decks/ensembleDeck.h"
+#include "inp/decks/materialDeck.h"
+#include "inp/decks/modelDeck.h"
+#include "inp/decks/outputDeck.h"
+#include "inp/input.h"
+#include "material/materials.h"
+#include "model/fd/fDModel.h"
+#include "util/compare.h"
+#include <algorithm>
+#include <hpx/include/async.hpp>
+#include <iostream>
+
+model::Ensemble::Ensemble(const std::string &filename)
+    : d_filename(filename), d_mesh_p(nullptr), d_interiorFlags_p(nullptr) {
+
+  // read input file for each member and apply overrides
+  auto base = new inp::Input(filename);
+  const auto &members = base->getEnsembleDeck()->d_members;
+  if (members.empty()) {
+    std::cerr << "Error: Ensemble has no members.\n";
+    exit(1);
+  }
+
+  d_inputs.resize(members.size());
+  d_memberHorizon.resize(members.size());
+  for (size_t i = 0; i < members.size(); i++) {
+    d_inputs[i] = i == 0 ? base : new inp::Input(filename);
+    applyMember(members[i], d_inputs[i]);
+
+    // find horizon in list of distinct horizons
+    double horizon = d_inputs[i]->getModelDeck()->d_horizon;
+    size_t k = 0;
+    for (; k < d_horizons.size(); k++)
+      if (util::compare::essentiallyEqual(horizon, d_horizons[k])) break;
+
+    if (k == d_horizons.size()) d_horizons.push_back(horizon);
+    d_memberHorizon[i] = k;
+  }
+
+  // create mesh and interior flags
+  std::cout << "Ensemble: Creating mesh.\n";
+  d_mesh_p = new fe::Mesh(base->getMeshDeck());
+  d_mesh_p->clearElementData();
+
+  std::cout << "number of nodes = " << d_mesh_p->getNumNodes()
+            << " number of elements = " << d_mesh_p->getNumElements() << "\n";
+
+  std::cout << "Ensemble: Creating interior flags for nodes.\n";
+  d_interiorFlags_p = new geometry::InteriorFlags(
+      base->getInteriorFlagsDeck(), d_mesh_p->getNodesP(),
+      d_mesh_p->getBoundingBox());
+
+  // create neighbor list and fracture state for each horizon
+  d_sharedData.resize(d_horizons.size(), nullptr);
+  for (size_t i = 0; i < members.size(); i++)
+    if (!d_sharedData[d_memberHorizon[i]])
+      d_sharedData[d_memberHorizon[i]] = createSharedData(d_inputs[i]);
+
+  run();
+}
+
+model::Ensemble::~Ensemble() {
+  for (auto &dm : d_sharedData) {
+    delete dm->getNeighborP();
+    delete dm->getFractureP();
+    delete dm;
+  }
+
+  delete d_interiorFlags_p;
+  delete d_mesh_p;
+
+  for (auto &deck : d_inputs) delete deck;
+}
+
+void model::Ensemble::applyMember(const inp::EnsembleMember &member,
+                                  inp::Input *deck) {
+  auto mat_deck = deck->getMaterialDeck();
+  auto &mat_data = mat_deck->d_matData;
+
+  if (member.d_E > 0.) mat_data.d_E = member.d_E;
+  if (member.d_K > 0.) mat_data.d_K = member.d_K;
+  if (member.d_Gc > 0.) mat_data.d_Gc = member.d_Gc;
+  if (member.d_KIc > 0.) mat_data.d_KIc = member.d_KIc;
+  if (member.d_density > 0.) mat_deck->d_density = member.d_density;
+
+  if (!mat_deck->d_computeParamsFromElastic &&
+      (member.d_E > 0. || member.d_K > 0. || member.d_Gc > 0. ||
+       member.d_KIc > 0.))
+    std::cout << "Warning: Ensemble member " << member.d_tag
+              << " overrides elastic and fracture properties but material "
+                 "parameters are not computed from them.\n";
+
+  if (member.d_horizonFactor > 0.)
+    deck->getModelDeck()->d_horizon *= member.d_horizonFactor;
+
+  // output files of member are prefixed by its tag
+  deck->getOutputDeck()->d_path += member.d_tag + "_";
+}
+
+data::DataManager *model::Ensemble::createSharedData(inp::Input *deck) {
+  auto dm = new data::DataManager();
+  dm->setMeshP(d_mesh_p);
+  dm->setInteriorFlagsP(d_interiorFlags_p);
+
+  std::cout << "Ensemble: Creating neighbor list for horizon = "
+            << deck->getModelDeck()->d_horizon << ".\n";
+  dm->setNeighborP(new geometry::Neighbor(deck->getModelDeck()->d_horizon,
+                                          deck->getNeighborDeck(),
+                                          d_mesh_p->getNodesP()));
+
+  std::cout << "Ensemble: Creating edge crack if any and modifying the "
+               "fracture state of bonds.\n";
+  dm->setFractureP(new geometry::Fracture(
+      deck->getFractureDeck(), d_mesh_p->getNodesP(),
+      dm->getNeighborP()->getNeighborsListP()));
+
+  return dm;
+}
+
+void model::Ensemble::run() {
+  size_t n = d_inputs.size();
+  size_t max_concurrent = d_inputs[0]->getEnsembleDeck()->d_maxConcurrent;
+
+  for (size_t b = 0; b < n; b += max_concurrent) {
+    size_t e = std::min(n, b + max_concurrent);
+    std::cout << "Ensemble: Running members " << b + 1 << " to " << e
+              << " of " << n << ".\n";
+
+    // initialize members one after another
+    std::vector<model::FDModel<material::pd::RNPBond> *> models;
+    for (size_t i = b; i < e; i++)
+      models.push_back(new model::FDModel<material::pd::RNPBond>(
+          d_inputs[i], d_sharedData[d_memberHorizon[i]]));
+
+    // integrate members concurrently
+    std::vector<hpx::future<void>> futures;
+    for (auto m : models)
+      futures.push_back(hpx::async([m]() { m->simulate(); }));
+
+    for (auto &f : futures) f.get();
+
+    for (auto m : models) delete m;
+  }
+}
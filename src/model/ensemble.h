@@ -0,0 +1,103 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MODEL_ENSEMBLE_H
+#define MODEL_ENSEMBLE_H
+
+#include <string>
+#include <vector>
+
+// forward declaration of class
+namespace fe {
+class Mesh;
+} // namespace fe
+
+namespace geometry {
+class InteriorFlags;
+} // namespace geometry
+
+namespace inp {
+class Input;
+struct EnsembleMember;
+} // namespace inp
+
+namespace data {
+class DataManager;
+} // namespace data
+
+namespace model {
+
+/*! @brief A class to run ensemble of finite difference simulations
+ *
+ * Simulation of input file is performed for each member listed in
+ * inp::EnsembleDeck with material data (and horizon) of the member. Mesh and
+ * interior flags are created once for all members, and neighbor list and
+ * initial fracture state of bonds are created once for each distinct
+ * horizon. These read-only data are shared by the FDModel of members.
+ *
+ * Members are run in batches of inp::EnsembleDeck::d_maxConcurrent. Members
+ * of batch are initialized one after another (initialization modifies the
+ * shared inp::Policy object) and then integrated concurrently on HPX
+ * runtime. Output files of member are prefixed by its tag.
+ *
+ * Only explicit time integration with RNPBond material is supported.
+ */
+class Ensemble {
+
+public:
+  /*!
+   * @brief Constructor
+   * @param filename Filename of input file
+   */
+  explicit Ensemble(const std::string &filename);
+
+  ~Ensemble();
+
+private:
+  /*!
+   * @brief Applies overrides of member to its input deck
+   * @param member Member data
+   * @param deck Input deck of member
+   */
+  void applyMember(const inp::EnsembleMember &member, inp::Input *deck);
+
+  /*!
+   * @brief Creates data shared by members with given horizon
+   * @param deck Input deck of one of the members with this horizon
+   * @return dataManager Data manager holding shared data
+   */
+  data::DataManager *createSharedData(inp::Input *deck);
+
+  /*! @brief Runs all members */
+  void run();
+
+  /*! @brief Input filename */
+  std::string d_filename;
+
+  /*! @brief Input decks of members */
+  std::vector<inp::Input *> d_inputs;
+
+  /*! @brief Mesh shared by all members */
+  fe::Mesh *d_mesh_p;
+
+  /*! @brief Interior flags shared by all members */
+  geometry::InteriorFlags *d_interiorFlags_p;
+
+  /*! @brief Distinct horizons of members */
+  std::vector<double> d_horizons;
+
+  /*! @brief Shared data for each distinct horizon */
+  std::vector<data::DataManager *> d_sharedData;
+
+  /*! @brief Id of horizon (and shared data) of each member */
+  std::vector<size_t> d_memberHorizon;
+};
+
+} // namespace model
+
+#endif // MODEL_ENSEMBLE_H
@@ -39,10 +39,14 @@
 #include "loading/initialCondition.h"
 #include "loading/uLoading.h"
 #include "material/materials.h"
+#include "model/inSitu.h"
 #include "model/util.h"
 
 // standard lib
+#include <algorithm>
 #include <fstream>
+#include <limits>
+#include <numeric>
 
 template <class T>
 model::FDModel<T>::FDModel(inp::Input *deck)
@@ -51,7 +55,11 @@ model::FDModel<T>::FDModel(inp::Input *deck)
       d_initialCondition_p(nullptr),
       d_material_p(nullptr),
       d_dampingGeom_p(nullptr),
-      d_stop(false) {
+      d_inSitu_p(nullptr),
+      d_shared_p(nullptr),
+      d_stop(false),
+      d_changedToSmall(false),
+      d_changedBackToLarge(false) {
   d_dataManager_p = new data::DataManager();
 
   d_dataManager_p->setModelDeckP(deck->getModelDeck());
@@ -66,23 +74,57 @@ model::FDModel<T>::FDModel(inp::Input *deck)
     run(deck);
 }
 
+template <class T>
+model::FDModel<T>::FDModel(inp::Input *deck, data::DataManager *shared)
+    : d_input_p(deck),
+      d_policy_p(nullptr),
+      d_initialCondition_p(nullptr),
+      d_material_p(nullptr),
+      d_dampingGeom_p(nullptr),
+      d_inSitu_p(nullptr),
+      d_shared_p(shared),
+      d_stop(false),
+      d_changedToSmall(false),
+      d_changedBackToLarge(false) {
+  d_dataManager_p = new data::DataManager();
+
+  d_dataManager_p->setModelDeckP(deck->getModelDeck());
+  d_dataManager_p->setOutputDeckP(deck->getOutputDeck());
+
+  d_policy_p = inp::Policy::getInstance(d_input_p->getPolicyDeck());
+  d_absorbingCondDeck_p = deck->getAbsorbingCondDeck();
+
+  if (d_dataManager_p->getModelDeckP()->d_isRestartActive) {
+    std::cerr << "Error: Restart is not supported for members of ensemble.\n";
+    exit(1);
+  }
+
+  // first initialize all the high level data
+  initHObjects();
+
+  // now initialize remaining data
+  init();
+}
+
 template <class T>
 model::FDModel<T>::~FDModel() {
-  delete d_dataManager_p->getMeshP();
+  // shared data is owned by the ensemble
+  if (!d_shared_p) {
+    delete d_dataManager_p->getMeshP();
+    delete d_dataManager_p->getNeighborP();
+    delete d_dataManager_p->getInteriorFlagsP();
+  }
   delete d_dataManager_p->getDisplacementLoadingP();
   delete d_dataManager_p->getForceLoadingP();
-  delete d_dataManager_p->getNeighborP();
   delete d_dataManager_p->getFractureP();
-  delete d_dataManager_p->getInteriorFlagsP();
   delete d_dataManager_p->getDisplacementP();
   delete d_dataManager_p->getVelocityP();
   delete d_dataManager_p->getForceP();
-  delete d_dataManager_p->getModelDeckP();
-  delete d_dataManager_p->getOutputDeckP();
 
   delete d_material_p;
   delete d_initialCondition_p;
   delete d_dampingGeom_p;
+  delete d_inSitu_p;
 
   delete d_dataManager_p;
 }
@@ -99,6 +141,12 @@ void model::FDModel<T>::run(inp::Input *deck) {
   integrate();
 }
 
+template <class T>
+void model::FDModel<T>::simulate() {
+  // integrate in time
+  integrate();
+}
+
 template <class T>
 void model::FDModel<T>::restart(inp::Input *deck) {
   d_restartDeck_p = deck->getRestartDeck();
@@ -113,18 +161,23 @@ void model::FDModel<T>::restart(inp::Input *deck) {
   d_n = d_restartDeck_p->d_step;
   d_time = double(d_n) * d_dataManager_p->getModelDeckP()->d_dt;
 
-  // read displacement and velocity from restart file
+  // read displacement and velocity from restart file (restart file has
+  // nodes in the order of mesh file)
+  const auto mesh = d_dataManager_p->getMeshP();
+  auto nodes = mesh->getNodes();
+  mesh->toOriginalOrder(&nodes);
 
   if (d_dataManager_p->getOutputDeckP()->d_outFormat == "vtu")
     rw::reader::readVtuFileRestart(d_restartDeck_p->d_file,
                                    d_dataManager_p->getDisplacementP(),
-                                   d_dataManager_p->getVelocityP(),
-                                   d_dataManager_p->getMeshP()->getNodesP());
+                                   d_dataManager_p->getVelocityP(), &nodes);
   else if (d_dataManager_p->getOutputDeckP()->d_outFormat == "msh")
     rw::reader::readMshFileRestart(d_restartDeck_p->d_file,
                                    d_dataManager_p->getDisplacementP(),
-                                   d_dataManager_p->getVelocityP(),
-                                   d_dataManager_p->getMeshP()->getNodesP());
+                                   d_dataManager_p->getVelocityP(), &nodes);
+
+  mesh->fromOriginalOrder(d_dataManager_p->getDisplacementP());
+  mesh->fromOriginalOrder(d_dataManager_p->getVelocityP());
 
   // integrate in time
   integrate();
@@ -133,37 +186,51 @@ void model::FDModel<T>::restart(inp::Input *deck) {
 template <class T>
 void model::FDModel<T>::initHObjects() {
   std::cout << "FDModel: Initializing high level objects.\n";
-  // read mesh data
-  std::cout << "FDModel: Creating mesh.\n";
-
-  d_dataManager_p->setMeshP(new fe::Mesh(d_input_p->getMeshDeck()));
-  d_dataManager_p->getMeshP()->clearElementData();
-
-  std::cout << "number of nodes = "
-            << d_dataManager_p->getMeshP()->getNumNodes()
-            << " number of elements = "
-            << d_dataManager_p->getMeshP()->getNumElements() << "\n";
-
-  // create neighbor list
-  std::cout << "FDModel: Creating neighbor list.\n";
-
-  d_dataManager_p->setNeighborP(new geometry::Neighbor(
-      d_dataManager_p->getModelDeckP()->d_horizon, d_input_p->getNeighborDeck(),
-      d_dataManager_p->getMeshP()->getNodesP()));
-
-  // create fracture data
-  std::cout << "FDModel: Creating edge crack if any and modifying the "
-               "fracture state of bonds.\n";
-  d_dataManager_p->setFractureP(new geometry::Fracture(
-      d_input_p->getFractureDeck(), d_dataManager_p->getMeshP()->getNodesP(),
-      d_dataManager_p->getNeighborP()->getNeighborsListP()));
-
-  // create interior flags
-  std::cout << "FDModel: Creating interior flags for nodes.\n";
-  d_dataManager_p->setInteriorFlagsP(new geometry::InteriorFlags(
-      d_input_p->getInteriorFlagsDeck(),
-      d_dataManager_p->getMeshP()->getNodesP(),
-      d_dataManager_p->getMeshP()->getBoundingBox()));
+  if (d_shared_p) {
+    // mesh, neighbor list and interior flags are read-only and are shared
+    // with other members of ensemble
+    d_dataManager_p->setMeshP(d_shared_p->getMeshP());
+    d_dataManager_p->setNeighborP(d_shared_p->getNeighborP());
+    d_dataManager_p->setInteriorFlagsP(d_shared_p->getInteriorFlagsP());
+
+    // copy initial fracture state of bonds (member tracks activation of
+    // cracks in its own deck)
+    d_dataManager_p->setFractureP(new geometry::Fracture(
+        *d_shared_p->getFractureP(), d_input_p->getFractureDeck()));
+  } else {
+    // read mesh data
+    std::cout << "FDModel: Creating mesh.\n";
+
+    d_dataManager_p->setMeshP(new fe::Mesh(d_input_p->getMeshDeck()));
+    d_dataManager_p->getMeshP()->clearElementData();
+
+    std::cout << "number of nodes = "
+              << d_dataManager_p->getMeshP()->getNumNodes()
+              << " number of elements = "
+              << d_dataManager_p->getMeshP()->getNumElements() << "\n";
+
+    // create neighbor list
+    std::cout << "FDModel: Creating neighbor list.\n";
+
+    d_dataManager_p->setNeighborP(new geometry::Neighbor(
+        d_dataManager_p->getModelDeckP()->d_horizon,
+        d_input_p->getNeighborDeck(),
+        d_dataManager_p->getMeshP()->getNodesP()));
+
+    // create fracture data
+    std::cout << "FDModel: Creating edge crack if any and modifying the "
+                 "fracture state of bonds.\n";
+    d_dataManager_p->setFractureP(new geometry::Fracture(
+        d_input_p->getFractureDeck(), d_dataManager_p->getMeshP()->getNodesP(),
+        d_dataManager_p->getNeighborP()->getNeighborsListP()));
+
+    // create interior flags
+    std::cout << "FDModel: Creating interior flags for nodes.\n";
+    d_dataManager_p->setInteriorFlagsP(new geometry::InteriorFlags(
+        d_input_p->getInteriorFlagsDeck(),
+        d_dataManager_p->getMeshP()->getNodesP(),
+        d_dataManager_p->getMeshP()->getBoundingBox()));
+  }
 
   // initialize initial condition class
   std::cout << "FDModel: Initializing initial condition object.\n";
@@ -186,6 +253,12 @@ void model::FDModel<T>::initHObjects() {
   std::cout << "FDModel: Initializing damping object.\n";
   d_dampingGeom_p = new geometry::DampingGeom(d_absorbingCondDeck_p,
                                               d_dataManager_p->getMeshP());
+
+  // initialize in-situ analysis class
+  if (d_dataManager_p->getOutputDeckP()->d_inSituDt > 0) {
+    std::cout << "FDModel: Initializing in-situ analysis object.\n";
+    d_inSitu_p = new model::InSitu(d_input_p, d_dataManager_p, d_material_p);
+  }
 }
 
 template <class T>
@@ -312,6 +385,121 @@ void model::FDModel<T>::init() {
       }
     }
   }  // handle output criteria exceptions
+
+  if (d_dataManager_p->getModelDeckP()->d_halfBond) initHalfBonds();
+
+  if (d_dataManager_p->getModelDeckP()->d_bondCompactionInterval > 0) {
+    std::cout << "FDModel: Creating list of active bonds.\n";
+    const auto neighbor = d_dataManager_p->getNeighborP();
+    d_activeBonds.resize(d_dataManager_p->getMeshP()->getNumNodes());
+    d_contactBonds.resize(d_activeBonds.size());
+    for (size_t i = 0; i < d_activeBonds.size(); i++) {
+      d_activeBonds[i].resize(neighbor->getNeighbors(i).size());
+      std::iota(d_activeBonds[i].begin(), d_activeBonds[i].end(), 0);
+    }
+    compactBonds();
+  }
+}
+
+template <class T>
+void model::FDModel<T>::initHalfBonds() {
+  std::cout << "FDModel: Creating half bond list.\n";
+
+  const auto neighbor = d_dataManager_p->getNeighborP();
+  const size_t nnodes = d_dataManager_p->getMeshP()->getNumNodes();
+  const size_t not_owned = std::numeric_limits<size_t>::max();
+
+  // returns local id of node i in neighbor list of node j (neighbor lists
+  // are sorted, but check in case they are not)
+  auto find_rev = [neighbor](size_t i, size_t j) {
+    const auto &j_neighs = neighbor->getNeighbors(j);
+    auto it = std::lower_bound(j_neighs.begin(), j_neighs.end(), i);
+    if (it == j_neighs.end() || *it != i)
+      it = std::find(j_neighs.begin(), j_neighs.end(), i);
+    return it == j_neighs.end() ? not_owned : size_t(it - j_neighs.begin());
+  };
+
+  // bond is evaluated by node with smaller id, or by the node which has the
+  // bond if only one of the nodes has other node in its neighbor list
+  d_halfBondIds.resize(nnodes);
+  std::vector<size_t> num_owned(nnodes, 0);
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      nnodes, [this, neighbor, &num_owned, &find_rev](boost::uint64_t i) {
+        const auto &i_neighs = neighbor->getNeighbors(i);
+        auto &ids = d_halfBondIds[i];
+        ids.resize(i_neighs.size());
+        for (size_t k = 0; k < i_neighs.size(); k++) {
+          auto j = i_neighs[k];
+          if (j > i || find_rev(i, j) == not_owned)
+            ids[k] = 2 * num_owned[i]++;
+          else
+            ids[k] = not_owned;
+        }
+      });
+  f.get();
+
+  // offset of half bonds of each node
+  std::vector<size_t> offset(nnodes, 0);
+  for (size_t i = 1; i < nnodes; i++)
+    offset[i] = offset[i - 1] + num_owned[i - 1];
+  size_t num_half_bonds = nnodes > 0 ? offset.back() + num_owned.back() : 0;
+
+  f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      nnodes, [this, &offset, not_owned](boost::uint64_t i) {
+        for (auto &id : d_halfBondIds[i])
+          if (id != not_owned) id += 2 * offset[i];
+      });
+  f.get();
+
+  // bonds evaluated by other node
+  f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      nnodes, [this, neighbor, &find_rev, not_owned](boost::uint64_t i) {
+        const auto &i_neighs = neighbor->getNeighbors(i);
+        auto &ids = d_halfBondIds[i];
+        for (size_t k = 0; k < i_neighs.size(); k++)
+          if (ids[k] == not_owned) {
+            auto j = i_neighs[k];
+            ids[k] = d_halfBondIds[j][find_rev(i, j)] + 1;
+          }
+      });
+  f.get();
+
+  d_halfBondForces.resize(2 * num_half_bonds);
+  d_halfBondStates.resize(num_half_bonds);
+
+  std::cout << "FDModel: Number of half bonds = " << num_half_bonds << "\n";
+}
+
+template <class T>
+void model::FDModel<T>::compactBonds() {
+  const auto neighbor = d_dataManager_p->getNeighborP();
+  const auto fracture = d_dataManager_p->getFractureP();
+  bool apply_contact = d_input_p->getMaterialDeck()->d_applyContact;
+
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      d_activeBonds.size(),
+      [this, neighbor, fracture, apply_contact](boost::uint64_t i) {
+        auto &active = d_activeBonds[i];
+
+        // bonds not in active list are broken, so check if any other bond
+        // is broken
+        auto num_broken = neighbor->getNeighbors(i).size() - active.size();
+        if (fracture->getNumFracturedBonds(i) == num_broken) return;
+
+        size_t n = 0;
+        for (auto k : active) {
+          if (!fracture->getBondState(i, k))
+            active[n++] = k;
+          else if (apply_contact)
+            d_contactBonds[i].push_back(k);
+        }
+        active.resize(n);
+      });
+  f.get();
 }
 
 template <class T>
@@ -333,12 +521,15 @@ void model::FDModel<T>::integrate() {
   computeForces();
 
   // perform output at the beginning
-  if (d_n == 0) {
+  if (d_n == 0 && d_dataManager_p->getOutputDeckP()->d_dtOut > 0) {
     if (d_policy_p->enablePostProcessing()) computePostProcFields();
 
     model::Output(d_input_p, d_dataManager_p, d_n, d_time);
   }
 
+  if (d_inSitu_p && d_inSitu_p->isActive(d_n))
+    d_inSitu_p->compute(d_n, d_time);
+
   // start time integration
   size_t i = d_n;
   for (i; i < d_dataManager_p->getModelDeckP()->d_Nt; i++) {
@@ -349,8 +540,13 @@ void model::FDModel<T>::integrate() {
              "velocity_verlet")
       integrateVerlet();
 
-    // handle general output
-    if ((d_n % d_dataManager_p->getOutputDeckP()->d_dtOut == 0) &&
+    // in-situ analysis
+    if (d_inSitu_p && d_inSitu_p->isActive(d_n))
+      d_inSitu_p->compute(d_n, d_time);
+
+    // handle general output (no output files if output interval is zero)
+    if (d_dataManager_p->getOutputDeckP()->d_dtOut > 0 &&
+        (d_n % d_dataManager_p->getOutputDeckP()->d_dtOut == 0) &&
         (d_n >= d_dataManager_p->getOutputDeckP()->d_dtOut)) {
       if (d_policy_p->enablePostProcessing()) computePostProcFields();
 
@@ -364,12 +560,18 @@ void model::FDModel<T>::integrate() {
     }
 
     // check for crack application
-    if (d_dataManager_p->getFractureP()->addCrack(
-            d_time, d_dataManager_p->getMeshP()->getNodesP(),
-            d_dataManager_p->getNeighborP()->getNeighborsListP())) {
+    bool crack_added = d_dataManager_p->getFractureP()->addCrack(
+        d_time, d_dataManager_p->getMeshP()->getNodesP(),
+        d_dataManager_p->getNeighborP()->getNeighborsListP());
+    if (crack_added) {
       // check if we need to modify the output frequency
       checkOutputCriteria();
     }
+
+    // remove broken bonds from list of active bonds
+    const auto interval =
+        d_dataManager_p->getModelDeckP()->d_bondCompactionInterval;
+    if (interval > 0 && (crack_added || d_n % interval == 0)) compactBonds();
   }  // loop over time steps
 }
 
@@ -529,6 +731,11 @@ void model::FDModel<T>::computeForces() {
   const auto &nodes = d_dataManager_p->getMeshP()->getNodes();
   const auto &volumes = d_dataManager_p->getMeshP()->getNodalVolumes();
 
+  if (!d_halfBondIds.empty()) {
+    computeHalfBondForces();
+    return;
+  }
+
   auto f = hpx::parallel::for_loop(
       hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
       d_dataManager_p->getMeshP()->getNumNodes(),
@@ -556,7 +763,7 @@ std::pair<double, util::Point3> model::FDModel<T>::computeForce(
 
   // inner loop over neighbors
   const auto &i_neighs = this->d_dataManager_p->getNeighborP()->getNeighbors(i);
-  for (size_t j = 0; j < i_neighs.size(); j++) {
+  auto add_bond = [this, i, &i_neighs, &force_i, &energy_i](size_t j) {
     auto j_id = i_neighs[j];
 
     auto fe_pair = d_material_p->getBondEF(i, j);
@@ -571,7 +778,15 @@ std::pair<double, util::Point3> model::FDModel<T>::computeForce(
       (*d_dataManager_p->getReactionForceP())[i] +=
           (this->d_dataManager_p->getMeshP()->getNodalVolume(i) *
            fe_pair.first);
-
+  };
+
+  // evaluate only unbroken bonds and broken bonds for contact if list of
+  // active bonds is available
+  if (d_activeBonds.empty())
+    for (size_t j = 0; j < i_neighs.size(); j++) add_bond(j);
+  else {
+    for (auto j : d_activeBonds[i]) add_bond(j);
+    for (auto j : d_contactBonds[i]) add_bond(j);
   }  // loop over neighboring nodes
 
   if (d_dataManager_p->getOutputDeckP()->isTagInOutput("Total_Reaction_Force"))
@@ -581,6 +796,85 @@ std::pair<double, util::Point3> model::FDModel<T>::computeForce(
   return std::make_pair(energy_i, force_i);
 }
 
+template <class T>
+void model::FDModel<T>::computeHalfBondForces() {
+  const size_t nnodes = d_dataManager_p->getMeshP()->getNumNodes();
+
+  // evaluate each bond once
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      nnodes, [this](boost::uint64_t i) {
+        const auto &ids = d_halfBondIds[i];
+        auto eval_bond = [this, i, &ids](size_t k) {
+          if (ids[k] % 2 == 1) return;
+
+          bool fs = false;
+          auto forces = d_material_p->getBondForces(i, k, fs);
+          d_halfBondForces[ids[k]] = forces.first;
+          d_halfBondForces[ids[k] + 1] = forces.second;
+          d_halfBondStates[ids[k] / 2] = fs;
+        };
+
+        // forces of broken bonds not in active or contact list are zero
+        if (d_activeBonds.empty())
+          for (size_t k = 0; k < ids.size(); k++) eval_bond(k);
+        else {
+          for (auto k : d_activeBonds[i]) eval_bond(k);
+          for (auto k : d_contactBonds[i]) eval_bond(k);
+        }
+      });
+  f.get();
+
+  bool reaction_force =
+      d_dataManager_p->getOutputDeckP()->isTagInOutput("Reaction_Force") or
+      d_dataManager_p->getOutputDeckP()->isTagInOutput("Total_Reaction_Force");
+  bool total_reaction_force =
+      d_dataManager_p->getOutputDeckP()->isTagInOutput("Total_Reaction_Force");
+
+  // add forces of bonds to nodes
+  f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      nnodes,
+      [this, reaction_force, total_reaction_force](boost::uint64_t i) {
+        auto force_i = util::Point3();
+        if (reaction_force) {
+          (*d_dataManager_p->getReactionForceP())[i] = util::Point3();
+          (*d_dataManager_p->getTotalReactionForceP())[i] = 0.;
+        }
+
+        const auto &ids = d_halfBondIds[i];
+        const auto &i_neighs = d_dataManager_p->getNeighborP()->getNeighbors(i);
+        auto add_bond = [this, i, &ids, &i_neighs, &force_i,
+                         reaction_force](size_t k) {
+          const auto &f_ik = d_halfBondForces[ids[k]];
+          force_i += f_ik;
+
+          // fracture state of bond evaluated by other node (bonds only break)
+          if (ids[k] % 2 == 1 && d_halfBondStates[ids[k] / 2] &&
+              !d_dataManager_p->getFractureP()->getBondState(i, k))
+            d_dataManager_p->getFractureP()->setBondState(i, k, true);
+
+          if (reaction_force && is_reaction_force(i, i_neighs[k]))
+            (*d_dataManager_p->getReactionForceP())[i] +=
+                d_dataManager_p->getMeshP()->getNodalVolume(i) * f_ik;
+        };
+
+        if (d_activeBonds.empty())
+          for (size_t k = 0; k < ids.size(); k++) add_bond(k);
+        else {
+          for (auto k : d_activeBonds[i]) add_bond(k);
+          for (auto k : d_contactBonds[i]) add_bond(k);
+        }
+
+        if (total_reaction_force)
+          (*d_dataManager_p->getTotalReactionForceP())[i] =
+              (*d_dataManager_p->getReactionForceP())[i].length();
+
+        (*d_dataManager_p->getForceP())[i] += force_i;
+      });
+  f.get();
+}
+
 template <class T>
 bool model::FDModel<T>::is_reaction_force(size_t i, size_t j) {
   auto xi = this->d_dataManager_p->getMeshP()->getNode(i);
@@ -696,6 +990,7 @@ void model::FDModel<T>::computePostProcFields() {
         for (size_t j = 0; j < i_neighs.size(); j++) {
           auto j_id = i_neighs[j];
 
+          // read state after getBondEF as it may break the bond
           auto fe_pair = this->d_material_p->getBondEF(i, j);
           auto fs = this->d_dataManager_p->getFractureP()->getBondState(i, j);
 
@@ -786,6 +1081,11 @@ void model::FDModel<T>::checkOutputCriteria() {
           d_dataManager_p->getOutputDeckP()->d_dtOutCriteria)
     return;
 
+  // if output is disabled (zero interval) there is nothing to change
+  if (d_dataManager_p->getOutputDeckP()->d_dtOutOld == 0 ||
+      d_dataManager_p->getOutputDeckP()->d_dtOutCriteria == 0)
+    return;
+
   // perform checks every dt large intervals
   if (d_n % d_dataManager_p->getOutputDeckP()->d_dtOutOld != 0) return;
 
@@ -801,11 +1101,10 @@ void model::FDModel<T>::checkOutputCriteria() {
     // change from large interval to small interval should be done only once
     // to do this, we check below flag which will be set to true in first
     // change to small from small interval
-    static bool changed_to_small = false;
     bool changed_to_small_at_current = false;
     if (d_dataManager_p->getOutputDeckP()->d_dtOut >
             d_dataManager_p->getOutputDeckP()->d_dtOutCriteria &&
-        !changed_to_small) {
+        !d_changedToSmall) {
       // get maximum from the damage data
       auto max = util::methods::max((*d_dataManager_p->getDamageFunctionP()));
 
@@ -827,7 +1126,7 @@ void model::FDModel<T>::checkOutputCriteria() {
               << "\n";
         fdump.close();
 
-        changed_to_small = true;
+        d_changedToSmall = true;
         changed_to_small_at_current = true;
       }
     }  // if current dt out is larger
@@ -841,8 +1140,7 @@ void model::FDModel<T>::checkOutputCriteria() {
     // change from small to large interval should be done only once
     // to do this, we check below flag which will be set to true in first
     // change to large from small interval
-    static bool changed_back_to_large = false;
-    if (!changed_to_small_at_current && !changed_back_to_large &&
+    if (!changed_to_small_at_current && !d_changedBackToLarge &&
         d_dataManager_p->getOutputDeckP()->d_outCriteria == "max_Z_stop" &&
         d_dataManager_p->getOutputDeckP()->d_dtOut <
             d_dataManager_p->getOutputDeckP()->d_dtOutOld) {
@@ -906,7 +1204,7 @@ void model::FDModel<T>::checkOutputCriteria() {
               << "\n";
         fdump.close();
 
-        changed_back_to_large = true;
+        d_changedBackToLarge = true;
 
         d_stop = true;
       }
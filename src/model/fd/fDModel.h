@@ -54,6 +54,7 @@ class DataManager;
 } // namespace data
 
 namespace model {
+class InSitu;
 
 /**
  * \defgroup Explicit Explicit
@@ -88,8 +89,27 @@ public:
    */
   explicit FDModel(inp::Input *deck);
 
+  /*!
+   * @brief Constructor of member of ensemble
+   *
+   * Mesh, neighbor list and interior flags are taken from the shared data
+   * manager and are not deleted by this object. Fracture state of bonds is
+   * copied as each member breaks its own bonds. Unlike the other
+   * constructor, this only initializes the data and simulation is performed
+   * by calling simulate().
+   *
+   * @param deck The input deck
+   * @param shared Data manager holding data shared by members of ensemble
+   */
+  FDModel(inp::Input *deck, data::DataManager *shared);
+
   ~FDModel();
 
+  /*!
+   * @brief Performs time integration of member of ensemble
+   */
+  void simulate();
+
 
 private:
   /*!
@@ -116,6 +136,17 @@ private:
    */
   std::pair<double, util::Point3> computeForce(const size_t &i);
 
+  /*!
+   * @brief Computes peridynamic forces evaluating each bond once
+   *
+   * Bonds are evaluated by the node with smaller id and the forces on both
+   * nodes are stored in d_halfBondForces. In second pass, each node adds the
+   * forces of its bonds and copies the fracture state of bonds evaluated by
+   * other node. Both passes write only the data of their node and therefore
+   * are free of conflicts.
+   */
+  void computeHalfBondForces();
+
   /*!
    * @brief Validates if there is a reaction force between node i and node j
    * @param i id of node i 
@@ -149,6 +180,19 @@ private:
    */
   void init();
 
+  /*!
+   * @brief Creates ids of half bonds for computeHalfBondForces
+   */
+  void initHalfBonds();
+
+  /*!
+   * @brief Removes broken bonds from list of active bonds
+   *
+   * Broken bonds are moved to list of contact bonds if contact is applied,
+   * otherwise they are not evaluated anymore as their force is zero.
+   */
+  void compactBonds();
+
   /** @}*/
 
   /**
@@ -256,6 +300,14 @@ private:
   /*! @brief flag to stop the simulation midway */
   bool d_stop;
 
+  /*! @brief Flag which indicates if output interval is changed to small
+   * interval (done only once) */
+  bool d_changedToSmall;
+
+  /*! @brief Flag which indicates if output interval is changed back to large
+   * interval (done only once) */
+  bool d_changedBackToLarge;
+
   /**
    * @name Data: High level objects
    */
@@ -276,9 +328,43 @@ private:
   /*! @brief Pointer to Material object */
   geometry::DampingGeom *d_dampingGeom_p;
 
+  /*! @brief Pointer to in-situ analysis object (nullptr if not enabled) */
+  model::InSitu *d_inSitu_p;
+
   /*! @brief Data Manager */
 	data::DataManager *d_dataManager_p;
 
+  /*! @brief Data manager holding shared data (nullptr if not in ensemble) */
+  data::DataManager *d_shared_p;
+
+  /*!
+   * @brief Ids of half bond forces of bonds in neighbor list
+   *
+   * For bond k of node i, entry is 2b if bond b is evaluated by node i and
+   * 2b + 1 otherwise. Empty if half bond evaluation is not enabled.
+   */
+  std::vector<std::vector<size_t>> d_halfBondIds;
+
+  /*!
+   * @brief Force on node evaluating the bond b (entry 2b) and on other node
+   * (entry 2b + 1)
+   */
+  std::vector<util::Point3> d_halfBondForces;
+
+  /*! @brief Fracture state of half bonds */
+  std::vector<uint8_t> d_halfBondStates;
+
+  /*!
+   * @brief Local ids of unbroken bonds of each node
+   *
+   * Empty if bond compaction is not enabled. In that case all bonds are
+   * evaluated.
+   */
+  std::vector<std::vector<size_t>> d_activeBonds;
+
+  /*! @brief Local ids of broken bonds of each node for contact forces */
+  std::vector<std::vector<size_t>> d_contactBonds;
+
   /** @}*/
 };
 
@@ -0,0 +1,232 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "inSitu.h"
+
+#include "data/DataManager.h"
+#include "fe/mesh.h"
+#include "geometry/neighbor.h"
+#include "inp/decks/modelDeck.h"
+#include "inp/decks/outputDeck.h"
+#include "inp/input.h"
+#include "material/pd/baseMaterial.h"
+#include "util/compare.h"
+#include <algorithm>
+#include <cmath>
+#include <hpx/include/parallel_algorithm.hpp>
+#include <iomanip>
+#include <iostream>
+
+model::InSitu::InSitu(inp::Input *deck, data::DataManager *dataManager,
+                      material::pd::BaseMaterial *material)
+    : d_dataManager_p(dataManager),
+      d_material_p(material),
+      d_dt(deck->getOutputDeck()->d_inSituDt),
+      d_crackTip(false),
+      d_strain(false),
+      d_dim(dataManager->getMeshP()->getDimension()),
+      d_horizon(deck->getModelDeck()->d_horizon),
+      d_cracks(deck->getFractureDeck()->d_cracks),
+      d_crackTime(0.) {
+
+  for (const auto &tag : deck->getOutputDeck()->d_inSituTags) {
+    if (tag == "Crack_Tip")
+      d_crackTip = true;
+    else if (tag == "Strain")
+      d_strain = true;
+    else {
+      std::cerr << "Error: In-situ analysis tag = " << tag
+                << " is not supported.\n";
+      exit(1);
+    }
+  }
+
+  const auto &path = deck->getOutputDeck()->d_path;
+  if (d_crackTip) {
+    d_crackFile.open(path + "in_situ_crack.csv");
+    d_crackFile << "crack_id, step, time, xt, yt, vxt, vyt, xb, yb, vxb, vyb\n";
+  }
+
+  if (d_strain) {
+    d_strainFile.open(path + "in_situ_strain.csv");
+    d_strainFile << "step, time, max_Z, max_Exx, max_Eyy, max_Ezz, max_Eyz, "
+                    "max_Exz, max_Exy\n";
+  }
+}
+
+bool model::InSitu::isActive(const size_t &n) const {
+  return d_dt > 0 && n % d_dt == 0 && (d_crackTip || d_strain);
+}
+
+void model::InSitu::compute(const size_t &n, const double &time) {
+  computeNodalData(d_strain);
+
+  if (d_crackTip) crackOutput(n, time);
+
+  if (d_strain) strainOutput(n, time);
+}
+
+void model::InSitu::computeNodalData(bool compute_strain) {
+  const auto mesh = d_dataManager_p->getMeshP();
+  const auto u = d_dataManager_p->getDisplacementP();
+  const auto neighbor = d_dataManager_p->getNeighborP();
+  const size_t nnodes = mesh->getNumNodes();
+
+  d_Z.resize(nnodes);
+  if (compute_strain) d_E.resize(nnodes);
+
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      nnodes, [this, mesh, u, neighbor, compute_strain](boost::uint64_t i) {
+        const auto &xi = mesh->getNode(i);
+        const auto &ui = (*u)[i];
+
+        // K = sum_j V_j xi (x) xi / |xi|^2 and
+        // G = sum_j V_j eta (x) xi / |xi|^2, where eta = u_j - u_i, so that
+        // displacement gradient is G K^{-1}
+        double K[3][3] = {{0., 0., 0.}, {0., 0., 0.}, {0., 0., 0.}};
+        double G[3][3] = {{0., 0., 0.}, {0., 0., 0.}, {0., 0., 0.}};
+        double z = 0.;
+
+        for (const auto &j : neighbor->getNeighbors(i)) {
+          const auto &xj = mesh->getNode(j);
+          auto dx = xj - xi;
+          auto r = dx.length();
+          if (!util::compare::definitelyGreaterThan(r, 1.0E-12)) continue;
+
+          auto du = (*u)[j] - ui;
+          auto sr = std::abs(d_material_p->getS(dx, du)) /
+                    d_material_p->getSc(r);
+          if (util::compare::definitelyLessThan(z, sr)) z = sr;
+
+          if (compute_strain) {
+            double w = mesh->getNodalVolume(j) / (r * r);
+            for (size_t a = 0; a < 3; a++)
+              for (size_t b = 0; b < 3; b++) {
+                K[a][b] += w * dx[a] * dx[b];
+                G[a][b] += w * du[a] * dx[b];
+              }
+          }
+        }
+
+        d_Z[i] = z;
+        if (!compute_strain) return;
+
+        // in 2-d, K is singular in z direction
+        for (size_t a = d_dim; a < 3; a++) K[a][a] = 1.;
+
+        double det = K[0][0] * (K[1][1] * K[2][2] - K[2][1] * K[1][2]) -
+                     K[0][1] * (K[1][0] * K[2][2] - K[2][0] * K[1][2]) +
+                     K[0][2] * (K[1][0] * K[2][1] - K[2][0] * K[1][1]);
+        if (!util::compare::definitelyGreaterThan(std::abs(det), 0.)) {
+          d_E[i] = util::SymMatrix3();
+          return;
+        }
+
+        double Kinv[3][3];
+        for (size_t a = 0; a < 3; a++)
+          for (size_t b = 0; b < 3; b++) {
+            // cofactor of K(b, a)
+            size_t b1 = (b + 1) % 3, b2 = (b + 2) % 3;
+            size_t a1 = (a + 1) % 3, a2 = (a + 2) % 3;
+            Kinv[a][b] = (K[b1][a1] * K[b2][a2] - K[b1][a2] * K[b2][a1]) / det;
+          }
+
+        double H[3][3];
+        for (size_t a = 0; a < 3; a++)
+          for (size_t b = 0; b < 3; b++) {
+            H[a][b] = 0.;
+            for (size_t c = 0; c < 3; c++) H[a][b] += G[a][c] * Kinv[c][b];
+          }
+
+        // small strain E = (H + H^T) / 2
+        auto &E = d_E[i];
+        E(0, 0) = H[0][0];
+        E(1, 1) = H[1][1];
+        E(2, 2) = H[2][2];
+        E(1, 2) = 0.5 * (H[1][2] + H[2][1]);
+        E(0, 2) = 0.5 * (H[0][2] + H[2][0]);
+        E(0, 1) = 0.5 * (H[0][1] + H[1][0]);
+      });  // parallel loop over nodes
+  f.get();
+}
+
+util::Point3 model::InSitu::findTip(const inp::EdgeCrack &crack,
+                                    bool top) const {
+  const auto mesh = d_dataManager_p->getMeshP();
+
+  auto p = top ? crack.d_pt : crack.d_pb;
+  auto t = crack.d_pt - crack.d_pb;
+  if (!util::compare::definitelyGreaterThan(t.length(), 0.)) return p;
+  t = t * (1. / t.length());
+  if (!top) t = t * -1.;
+
+  double band = 4. * d_horizon;
+  double s_max = 0.;
+  auto tip = p;
+  for (size_t i = 0; i < mesh->getNumNodes(); i++) {
+    if (util::compare::definitelyLessThan(d_Z[i], 1.)) continue;
+
+    auto dx = mesh->getNode(i) - p;
+    double s = dx.dot(t);
+    if (!util::compare::definitelyGreaterThan(s, s_max)) continue;
+
+    // distance from crack line
+    if (util::compare::definitelyGreaterThan((dx - s * t).length(), band))
+      continue;
+
+    s_max = s;
+    tip = mesh->getNode(i);
+  }
+
+  return tip;
+}
+
+void model::InSitu::crackOutput(const size_t &n, const double &time) {
+  double dt = time - d_crackTime;
+
+  for (size_t c = 0; c < d_cracks.size(); c++) {
+    auto &crack = d_cracks[c];
+
+    auto pt = findTip(crack, true);
+    auto pb = findTip(crack, false);
+    if (util::compare::definitelyGreaterThan(dt, 0.)) {
+      crack.d_vt = (pt - crack.d_pt) * (1. / dt);
+      crack.d_vb = (pb - crack.d_pb) * (1. / dt);
+    }
+    crack.d_oldPt = crack.d_pt;
+    crack.d_oldPb = crack.d_pb;
+    crack.d_pt = pt;
+    crack.d_pb = pb;
+
+    d_crackFile << c + 1 << ", " << n << ", " << std::scientific
+                << std::setprecision(8) << time << ", " << pt.d_x << ", "
+                << pt.d_y << ", " << crack.d_vt.d_x << ", " << crack.d_vt.d_y
+                << ", " << pb.d_x << ", " << pb.d_y << ", " << crack.d_vb.d_x
+                << ", " << crack.d_vb.d_y << "\n";
+  }
+  d_crackFile.flush();
+
+  d_crackTime = time;
+}
+
+void model::InSitu::strainOutput(const size_t &n, const double &time) {
+  double max_Z = 0.;
+  double max_E[6] = {0., 0., 0., 0., 0., 0.};
+  for (size_t i = 0; i < d_Z.size(); i++) {
+    max_Z = std::max(max_Z, d_Z[i]);
+    for (size_t k = 0; k < 6; k++)
+      max_E[k] = std::max(max_E[k], double(std::abs(d_E[i].get(k))));
+  }
+
+  d_strainFile << n << ", " << std::scientific << std::setprecision(8) << time
+               << ", " << max_Z;
+  for (double e : max_E) d_strainFile << ", " << e;
+  d_strainFile << "\n";
+  d_strainFile.flush();
+}
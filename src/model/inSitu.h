@@ -0,0 +1,156 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef MODEL_INSITU_H
+#define MODEL_INSITU_H
+
+#include "inp/decks/fractureDeck.h" // definition of EdgeCrack
+#include "util/matrix.h"            // definition of SymMatrix3
+#include "util/point.h"             // definition of Point3
+#include <fstream>
+#include <string>
+#include <vector>
+
+// forward declaration of class
+namespace inp {
+class Input;
+} // namespace inp
+
+namespace material {
+namespace pd {
+class BaseMaterial;
+}
+} // namespace material
+
+namespace data {
+class DataManager;
+} // namespace data
+
+namespace model {
+
+/*! @brief A class to perform in-situ analysis of simulation
+ *
+ * Computes selected post-processing quantities on the current simulation
+ * data at given interval of time steps and writes compact results to csv
+ * files in output path. This avoids writing full output files and reading
+ * them again in post-processing tool when only the analysis results are of
+ * interest. Quantities are selected with tags:
+ *
+ * - **Crack_Tip** Tracks top (right) and bottom (left) tip of each crack in
+ * fracture deck and its velocity. Results are written to in_situ_crack.csv.
+ *
+ * - **Strain** Computes nonlocal strain tensor at nodes and writes maximum
+ * damage and maximum of absolute value of each strain component to
+ * in_situ_strain.csv.
+ *
+ * Damage at node is the maximum over bonds of ratio of bond strain and
+ * critical strain (same as in post-processing tool).
+ *
+ * Crack tip is the damaged node (damage above 1) farthest along the crack
+ * line from the current tip within the band of width 4 times horizon
+ * around the crack line. Crack tip only advances and is computed in
+ * reference configuration.
+ */
+class InSitu {
+
+public:
+  /*!
+   * @brief Constructor
+   * @param deck Input deck
+   * @param dataManager Data manager holding the simulation data
+   * @param material Material
+   */
+  InSitu(inp::Input *deck, data::DataManager *dataManager,
+         material::pd::BaseMaterial *material);
+
+  /*!
+   * @brief Returns true if analysis is performed at given time step
+   * @param n Time step
+   * @return bool True if analysis is performed
+   */
+  bool isActive(const size_t &n) const;
+
+  /*!
+   * @brief Performs analysis and writes results
+   * @param n Time step
+   * @param time Current time
+   */
+  void compute(const size_t &n, const double &time);
+
+private:
+  /*!
+   * @brief Computes damage (and strain if required) at nodes
+   * @param compute_strain Flag to compute strain
+   */
+  void computeNodalData(bool compute_strain);
+
+  /*!
+   * @brief Finds new tip of crack
+   * @param crack Crack
+   * @param top Flag specifying top (right) or bottom (left) tip
+   * @return tip New tip
+   */
+  util::Point3 findTip(const inp::EdgeCrack &crack, bool top) const;
+
+  /*!
+   * @brief Updates crack tips and writes them
+   * @param n Time step
+   * @param time Current time
+   */
+  void crackOutput(const size_t &n, const double &time);
+
+  /*!
+   * @brief Writes damage and strain data
+   * @param n Time step
+   * @param time Current time
+   */
+  void strainOutput(const size_t &n, const double &time);
+
+  /*! @brief Pointer to data manager */
+  data::DataManager *d_dataManager_p;
+
+  /*! @brief Pointer to material */
+  material::pd::BaseMaterial *d_material_p;
+
+  /*! @brief Interval of time steps for analysis */
+  size_t d_dt;
+
+  /*! @brief Track crack tips */
+  bool d_crackTip;
+
+  /*! @brief Compute strain */
+  bool d_strain;
+
+  /*! @brief Dimension */
+  size_t d_dim;
+
+  /*! @brief Horizon */
+  double d_horizon;
+
+  /*! @brief Cracks with current tips and velocity of tips */
+  std::vector<inp::EdgeCrack> d_cracks;
+
+  /*! @brief Time of last crack tip update */
+  double d_crackTime;
+
+  /*! @brief Damage at nodes */
+  std::vector<double> d_Z;
+
+  /*! @brief Strain at nodes */
+  std::vector<util::SymMatrix3> d_E;
+
+  /*! @brief File for crack tip data */
+  std::ofstream d_crackFile;
+
+  /*! @brief File for strain data */
+  std::ofstream d_strainFile;
+};
+
+} // namespace model
+
+#endif // MODEL_INSITU_H
@@ -6,5 +6,6 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 ////////////////////////////////////////////////////////////////////////////////
 
+#include "ensemble.h"
 #include "fd/fDModel.h"
 #include "quasistatic/QuasiStaticModel.h"
@@ -14,6 +14,7 @@
 #include "inp/decks/outputDeck.h"
 #include "inp/decks/solverDeck.h"
 #include "inp/input.h"
+#include "inp/policy.h"
 #include "loading/fLoading.h"
 #include "loading/initialCondition.h"
 #include "loading/uLoading.h"
@@ -25,6 +26,11 @@
 template <class T>
 model::QuasiStaticModel<T>::QuasiStaticModel(inp::Input *deck)
     : d_modelDeck_p(nullptr), d_outputDeck_p(nullptr) {
+  // create policy from input deck before any object queries it
+  d_policy_p = inp::Policy::getInstance(deck->getPolicyDeck());
+  std::cout << "QuasiStaticModel: Memory control level = "
+            << d_policy_p->getMemoryControlFlag() << std::endl;
+
   d_osThreads = hpx::get_os_thread_count();
 
   // Generate as many data manager as os threads are avaibale
@@ -44,8 +50,6 @@ model::QuasiStaticModel<T>::QuasiStaticModel(inp::Input *deck)
 
   d_input_p = deck;
 
-  // d_policy_p = inp::Policy::getInstance(d_input_p->getPolicyDeck());
-
   // if (d_modelDeck_p->d_isRestartActive)
   // restart(deck);
   // else
@@ -204,6 +204,9 @@ private:
 	/*! @brief Pointer to Input object */
 	inp::Input *d_input_p;
 
+	/*! @brief Pointer to Policy object */
+	inp::Policy *d_policy_p;
+
 	/*! @brief Pointer to Material object */
 	material::pd::BaseMaterial *d_material_p;
 
@@ -22,7 +22,11 @@ model::Output::Output(inp::Input *d_input_p, data::DataManager *d_dataManager_p,
   // open
   auto writer =
       rw::writer::Writer(filename, d_input_p->getOutputDeck()->d_outFormat,
-                         d_input_p->getOutputDeck()->d_compressType);
+                         d_input_p->getOutputDeck()->d_compressType,
+                         d_input_p->getOutputDeck()->d_numPieces);
+
+  // write nodal data in the order of nodes in mesh file
+  writer.setNodeOrder(&d_dataManager_p->getMeshP()->getOriginalNodeIds());
 
   // write mesh
   if (d_dataManager_p->getMeshP()->getNumElements() != 0 &&
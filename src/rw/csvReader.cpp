@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "csvReader.h"
+
+#include <charconv>
+#include <cstring>
+#include <fcntl.h>
+#include <hpx/include/parallel_algorithm.hpp>
+#include <iostream>
+#include <string_view>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+/*! @brief Size of chunk of file parsed by one task */
+const size_t csv_chunk_size = 4 * 1024 * 1024;
+
+bool isBlank(char c) { return c == ' ' || c == '\t' || c == '\r'; }
+
+/*! @brief Returns pointer to the '\n' ending the line or end of data */
+const char *lineEnd(const char *p, const char *end) {
+  auto q = static_cast<const char *>(std::memchr(p, '\n', size_t(end - p)));
+  return q == nullptr ? end : q;
+}
+
+bool isEmptyLine(const char *b, const char *e) {
+  while (b < e && isBlank(*b)) b++;
+  return b == e;
+}
+
+/*! @brief Removes white spaces and quotes around field */
+std::string_view trim(const char *b, const char *e) {
+  while (b < e && isBlank(*b)) b++;
+  while (e > b && isBlank(*(e - 1))) e--;
+  if (e - b >= 2 && *b == '"' && *(e - 1) == '"') {
+    b++;
+    e--;
+  }
+  return std::string_view(b, size_t(e - b));
+}
+
+bool parseField(std::string_view s, double &val) {
+  const char *b = s.data();
+  const char *e = b + s.size();
+  if (b < e && *b == '+') b++;
+  auto res = std::from_chars(b, e, val);
+  return res.ec == std::errc() && res.ptr == e;
+}
+
+/*!
+ * @brief Parses a line into values
+ *
+ * Column i of the line is stored in vals[col_map[i]] if col_map[i] is not
+ * negative.
+ *
+ * @return status True if all required values are found
+ */
+bool parseLine(const char *b, const char *e, const std::vector<int> &col_map,
+               size_t num_vals, double *vals) {
+  size_t found = 0;
+  size_t col = 0;
+  while (col < col_map.size()) {
+    auto q = static_cast<const char *>(std::memchr(b, ',', size_t(e - b)));
+    const char *field_end = q == nullptr ? e : q;
+
+    if (col_map[col] >= 0) {
+      if (!parseField(trim(b, field_end), vals[col_map[col]])) return false;
+      found++;
+    }
+
+    col++;
+    if (q == nullptr) break;
+    b = q + 1;
+  }
+
+  return found == num_vals;
+}
+
+} // namespace
+
+rw::reader::CsvReader::CsvReader(const std::string &filename)
+    : d_filename(filename), d_data_p(nullptr), d_size(0){};
+
+rw::reader::CsvReader::~CsvReader() { close(); }
+
+void rw::reader::CsvReader::open() {
+  if (d_data_p != nullptr) return;
+
+  int fd = ::open(d_filename.c_str(), O_RDONLY);
+  struct stat st;
+  if (fd < 0 || fstat(fd, &st) != 0) {
+    std::cerr << "Error: Can not open file = " << d_filename << ".\n";
+    exit(1);
+  }
+
+  d_size = size_t(st.st_size);
+  if (d_size == 0) {
+    std::cerr << "Error: File = " << d_filename << " is empty.\n";
+    exit(1);
+  }
+
+  void *data = mmap(nullptr, d_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (data == MAP_FAILED) {
+    std::cerr << "Error: Can not map file = " << d_filename
+              << " into memory.\n";
+    exit(1);
+  }
+
+  // file is read sequentially by each task
+  madvise(data, d_size, MADV_SEQUENTIAL);
+  d_data_p = static_cast<const char *>(data);
+}
+
+void rw::reader::CsvReader::readNodes(size_t dim,
+                                      std::vector<util::Point3> *nodes,
+                                      std::vector<double> *volumes,
+                                      std::vector<uint8_t> *fixity) {
+  open();
+
+  const char *begin = d_data_p;
+  const char *end = d_data_p + d_size;
+
+  // skip UTF-8 byte order mark
+  if (d_size >= 3 && std::memcmp(begin, "\xEF\xBB\xBF", 3) == 0) begin += 3;
+
+  //
+  // read header and map columns to values
+  // values are stored as: coordinates (dim), volume, fixity
+  //
+  std::vector<std::string> names = {"x", "y", "z"};
+  names.resize(dim);
+  names.emplace_back("volume");
+  size_t num_required = names.size();
+  if (fixity != nullptr) names.emplace_back("fixity");
+
+  const char *header_end = lineEnd(begin, end);
+  std::vector<int> col_map;
+  std::vector<bool> found(names.size(), false);
+  {
+    const char *b = begin;
+    while (true) {
+      auto q = static_cast<const char *>(
+          std::memchr(b, ',', size_t(header_end - b)));
+      const char *field_end = q == nullptr ? header_end : q;
+      auto field = trim(b, field_end);
+
+      int slot = -1;
+      for (size_t i = 0; i < names.size(); i++)
+        if (!found[i] && field == names[i]) {
+          slot = int(i);
+          found[i] = true;
+          break;
+        }
+      col_map.push_back(slot);
+
+      if (q == nullptr) break;
+      b = q + 1;
+    }
+  }
+
+  for (size_t i = 0; i < num_required; i++)
+    if (!found[i]) {
+      std::cerr << "Error: Column = " << names[i]
+                << " not found in header of file = " << d_filename << ".\n";
+      exit(1);
+    }
+
+  bool read_fixity = fixity != nullptr && found[num_required];
+  size_t num_vals = read_fixity ? num_required + 1 : num_required;
+  if (!read_fixity)
+    for (auto &c : col_map)
+      if (c == int(num_required)) c = -1;
+
+  //
+  // split data into chunks at line boundaries
+  //
+  const char *data_begin = header_end < end ? header_end + 1 : end;
+  std::vector<const char *> chunks = {data_begin};
+  while (size_t(end - chunks.back()) > csv_chunk_size) {
+    const char *p = lineEnd(chunks.back() + csv_chunk_size, end);
+    if (p == end) break;
+    chunks.push_back(p + 1);
+  }
+  chunks.push_back(end);
+  size_t num_chunks = chunks.size() - 1;
+
+  //
+  // count lines in each chunk
+  //
+  std::vector<size_t> chunk_rows(num_chunks + 1, 0);
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      num_chunks, [&chunks, &chunk_rows](boost::uint64_t k) {
+        size_t n = 0;
+        const char *p = chunks[k];
+        while (p < chunks[k + 1]) {
+          const char *e = lineEnd(p, chunks[k + 1]);
+          if (!isEmptyLine(p, e)) n++;
+          p = e + 1;
+        }
+        chunk_rows[k + 1] = n;
+      });
+  f.get();
+
+  // offset of first row of chunk
+  for (size_t k = 0; k < num_chunks; k++) chunk_rows[k + 1] += chunk_rows[k];
+  size_t num_rows = chunk_rows[num_chunks];
+
+  //
+  // parse chunks directly into output vectors
+  //
+  nodes->resize(num_rows);
+  volumes->resize(num_rows);
+  if (read_fixity)
+    fixity->resize(num_rows);
+  else if (fixity != nullptr)
+    fixity->clear();
+
+  // first row in each chunk which could not be parsed
+  std::vector<size_t> chunk_error(num_chunks, num_rows);
+  auto g = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      num_chunks,
+      [&chunks, &chunk_rows, &chunk_error, &col_map, num_vals, dim,
+       read_fixity, nodes, volumes, fixity](boost::uint64_t k) {
+        double vals[5] = {0., 0., 0., 0., 0.};
+        size_t row = chunk_rows[k];
+        const char *p = chunks[k];
+        while (p < chunks[k + 1]) {
+          const char *e = lineEnd(p, chunks[k + 1]);
+          if (!isEmptyLine(p, e)) {
+            if (!parseLine(p, e, col_map, num_vals, vals)) {
+              chunk_error[k] = row;
+              return;
+            }
+
+            auto &x = (*nodes)[row];
+            x = util::Point3();
+            for (size_t i = 0; i < dim; i++) x[i] = vals[i];
+            (*volumes)[row] = vals[dim];
+            if (read_fixity) (*fixity)[row] = uint8_t(vals[dim + 1]);
+            row++;
+          }
+          p = e + 1;
+        }
+      });
+  g.get();
+
+  for (size_t k = 0; k < num_chunks; k++)
+    if (chunk_error[k] < num_rows) {
+      std::cerr << "Error: Can not parse data row = " << chunk_error[k] + 1
+                << " in file = " << d_filename << ".\n";
+      exit(1);
+    }
+}
+
+void rw::reader::CsvReader::close() {
+  if (d_data_p == nullptr) return;
+
+  munmap(const_cast<char *>(d_data_p), d_size);
+  d_data_p = nullptr;
+  d_size = 0;
+}
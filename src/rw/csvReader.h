@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RW_CSVREADER_H
+#define RW_CSVREADER_H
+
+#include "util/point.h" // definition of Point3
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rw {
+
+namespace reader {
+
+/*!
+ * @brief A class to read point cloud mesh from csv files
+ *
+ * The first line of the file is the header with the name of columns. Columns
+ * x, volume (1-d), x, y, volume (2-d) or x, y, z, volume (3-d) are required
+ * and column fixity is optional. Other columns, e.g. id, are ignored and the
+ * order of columns is arbitrary.
+ *
+ * The file is memory mapped and split into chunks at line boundaries. Lines
+ * in each chunk are first counted in parallel so that the output vectors are
+ * allocated once, and then the chunks are parsed in parallel directly into
+ * the output vectors.
+ */
+class CsvReader {
+
+public:
+  /*!
+   * @brief Constructor
+   * @param filename Name of the mesh file
+   */
+  explicit CsvReader(const std::string &filename);
+
+  /*! @brief Destructor */
+  ~CsvReader();
+
+  /*! @brief Copying is not allowed as the reader owns the memory mapping */
+  CsvReader(const CsvReader &) = delete;
+
+  /*! @brief Copying is not allowed as the reader owns the memory mapping */
+  CsvReader &operator=(const CsvReader &) = delete;
+
+  /*!
+   * @brief Reads nodes, nodal volume and (if present) nodal fixity
+   * @param dim Dimension
+   * @param nodes Vector of nodes data
+   * @param volumes Vector holding volume of the nodes
+   * @param fixity Vector holding fixity mask of the nodes. It is left empty
+   * if the file does not have fixity column.
+   */
+  void readNodes(size_t dim, std::vector<util::Point3> *nodes,
+                 std::vector<double> *volumes,
+                 std::vector<uint8_t> *fixity = nullptr);
+
+  /*! @brief Close the file */
+  void close();
+
+private:
+  /*! @brief Maps the file into memory */
+  void open();
+
+  /*! @brief filename */
+  std::string d_filename;
+
+  /*! @brief Pointer to the memory mapped file */
+  const char *d_data_p;
+
+  /*! @brief Size of file */
+  size_t d_size;
+};
+
+} // namespace reader
+
+} // namespace rw
+
+#endif // RW_CSVREADER_H
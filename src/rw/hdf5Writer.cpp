@@ -0,0 +1,547 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "hdf5Writer.h"
+
+#include <hdf5.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+
+#include "util/feElementDefs.h"
+
+namespace {
+
+/*! @brief Point data which is written only once */
+const std::vector<std::string> static_point_data = {"Fixity", "Node_Volume",
+                                                    "Neighbors"};
+
+/*! @brief Closing tags of XDMF file */
+const std::string xdmf_footer = "    </Grid>\n  </Domain>\n</Xdmf>\n";
+
+/*! @brief Maximum number of rows in one chunk of dataset */
+const size_t max_chunk_rows = 65536;
+
+/*! @brief Checks if link (group or dataset) exists */
+bool linkExists(hid_t loc, const std::string &name) {
+  return H5Lexists(loc, name.c_str(), H5P_DEFAULT) > 0;
+}
+
+/*! @brief Opens the group and creates it if it does not exist */
+hid_t openGroup(hid_t loc, const std::string &name) {
+  if (linkExists(loc, name))
+    return H5Gopen2(loc, name.c_str(), H5P_DEFAULT);
+  return H5Gcreate2(loc, name.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+}
+
+/*! @brief Returns the dimensions of dataset */
+std::vector<hsize_t> getDims(hid_t loc, const std::string &name) {
+  auto dset = H5Dopen2(loc, name.c_str(), H5P_DEFAULT);
+  auto space = H5Dget_space(dset);
+  std::vector<hsize_t> dims(H5Sget_simple_extent_ndims(space));
+  H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+  H5Sclose(space);
+  H5Dclose(dset);
+  return dims;
+}
+
+/*! @brief Returns names of all links in group */
+std::vector<std::string> getNames(hid_t loc, const std::string &name) {
+  std::vector<std::string> names;
+  if (!linkExists(loc, name)) return names;
+
+  auto group = H5Gopen2(loc, name.c_str(), H5P_DEFAULT);
+  H5G_info_t info;
+  H5Gget_info(group, &info);
+  for (hsize_t i = 0; i < info.nlinks; i++) {
+    auto n = H5Lget_name_by_idx(group, ".", H5_INDEX_NAME, H5_ITER_INC, i,
+                                nullptr, 0, H5P_DEFAULT);
+    std::string s(n + 1, '\0');
+    H5Lget_name_by_idx(group, ".", H5_INDEX_NAME, H5_ITER_INC, i, &s[0],
+                       n + 1, H5P_DEFAULT);
+    s.resize(n);
+    names.push_back(s);
+  }
+  H5Gclose(group);
+  return names;
+}
+
+/*!
+ * @brief Writes the data as chunked (and optionally compressed) dataset of
+ * size rows x cols
+ *
+ * Existing dataset of the same name is replaced.
+ */
+void writeDataset(hid_t loc, const std::string &name, hid_t mem_type,
+                  hid_t file_type, const void *data, size_t rows, size_t cols,
+                  bool compress) {
+  if (linkExists(loc, name)) H5Ldelete(loc, name.c_str(), H5P_DEFAULT);
+
+  hsize_t dims[2] = {rows, cols};
+  auto space = H5Screate_simple(2, dims, nullptr);
+
+  auto plist = H5Pcreate(H5P_DATASET_CREATE);
+  if (rows > 0) {
+    hsize_t chunk[2] = {std::min(rows, max_chunk_rows), cols};
+    H5Pset_chunk(plist, 2, chunk);
+    if (compress) {
+      H5Pset_shuffle(plist);
+      H5Pset_deflate(plist, 4);
+    }
+  }
+
+  auto dset = H5Dcreate2(loc, name.c_str(), file_type, space, H5P_DEFAULT,
+                         plist, H5P_DEFAULT);
+  if (dset < 0) {
+    std::cerr << "Error: Can not create dataset = " << name
+              << " in HDF5 file.\n";
+    exit(1);
+  }
+  if (rows > 0)
+    H5Dwrite(dset, mem_type, H5S_ALL, H5S_ALL, H5P_DEFAULT, data);
+
+  H5Dclose(dset);
+  H5Pclose(plist);
+  H5Sclose(space);
+}
+
+/*! @brief Writes the scalar attribute (replaces existing attribute) */
+void writeAttribute(hid_t loc, const std::string &name, double value) {
+  if (H5Aexists(loc, name.c_str()) > 0) H5Adelete(loc, name.c_str());
+
+  auto space = H5Screate(H5S_SCALAR);
+  auto attr = H5Acreate2(loc, name.c_str(), H5T_IEEE_F64LE, space,
+                         H5P_DEFAULT, H5P_DEFAULT);
+  H5Awrite(attr, H5T_NATIVE_DOUBLE, &value);
+  H5Aclose(attr);
+  H5Sclose(space);
+}
+
+/*! @brief Reads the scalar attribute (returns default if not found) */
+double readAttribute(hid_t loc, const std::string &name, double value = 0.) {
+  if (H5Aexists(loc, name.c_str()) <= 0) return value;
+
+  auto attr = H5Aopen(loc, name.c_str(), H5P_DEFAULT);
+  H5Aread(attr, H5T_NATIVE_DOUBLE, &value);
+  H5Aclose(attr);
+  return value;
+}
+
+/*! @brief Returns XDMF topology type of vtk element type */
+std::string getXdmfTopology(int element_type) {
+  if (element_type == util::vtk_type_triangle) return "Triangle";
+  if (element_type == util::vtk_type_quad) return "Quadrilateral";
+  if (element_type == util::vtk_type_tetra) return "Tetrahedron";
+  return "Polyvertex";
+}
+
+/*! @brief Returns XDMF attribute type for data with given components */
+std::string getXdmfAttributeType(size_t cols) {
+  if (cols == 1) return "Scalar";
+  if (cols == 3) return "Vector";
+  if (cols == 6) return "Tensor6";
+  return "Matrix";
+}
+
+/*! @brief Returns XDMF data item referring to dataset in HDF5 file */
+std::string getXdmfDataItem(const std::string &h5_filename,
+                            const std::string &path,
+                            const std::vector<hsize_t> &dims,
+                            const std::string &number_type = "Float") {
+  std::string s = "<DataItem Dimensions=\"";
+  for (size_t i = 0; i < dims.size(); i++)
+    s += (i > 0 ? " " : "") + std::to_string(dims[i]);
+  s += "\" NumberType=\"" + number_type + "\" Precision=\"8\" Format=\"HDF\">";
+  s += h5_filename + ":" + path + "</DataItem>";
+  return s;
+}
+
+/*! @brief Returns XDMF grid of the output step stored in HDF5 file */
+std::string getXdmfGrid(hid_t file, const std::string &h5_filename,
+                        const std::string &step, double time) {
+  // mesh
+  auto node_dims = getDims(file, "Mesh/Nodes");
+  std::string topology = "<Topology TopologyType=\"Polyvertex\" "
+                         "NodesPerElement=\"1\" NumberOfElements=\"" +
+                         std::to_string(node_dims[0]) + "\"/>";
+  if (linkExists(file, "Mesh/Connectivity")) {
+    auto mesh = H5Gopen2(file, "Mesh", H5P_DEFAULT);
+    auto element_type = int(readAttribute(mesh, "Element_Type"));
+    H5Gclose(mesh);
+
+    auto con_dims = getDims(file, "Mesh/Connectivity");
+    topology = "<Topology TopologyType=\"" + getXdmfTopology(element_type) +
+               "\" NumberOfElements=\"" + std::to_string(con_dims[0]) +
+               "\">\n        " +
+               getXdmfDataItem(h5_filename, "/Mesh/Connectivity", con_dims,
+                               "UInt") +
+               "\n      </Topology>";
+  }
+
+  auto path = "Steps/" + step;
+  std::string s = "    <Grid Name=\"" + step + "\" GridType=\"Uniform\">\n";
+  char time_str[64];
+  snprintf(time_str, sizeof(time_str), "%.16g", time);
+  s += "      <Time Value=\"" + std::string(time_str) + "\"/>\n";
+  s += "      " + topology + "\n";
+
+  // current position of nodes is reference position plus displacement
+  auto nodes_item = getXdmfDataItem(h5_filename, "/Mesh/Nodes", node_dims);
+  s += "      <Geometry GeometryType=\"XYZ\">\n";
+  if (linkExists(file, path + "/PointData/Displacement")) {
+    s += "        <DataItem ItemType=\"Function\" Function=\"$0 + $1\" "
+         "Dimensions=\"" +
+         std::to_string(node_dims[0]) + " 3\">\n";
+    s += "          " + nodes_item + "\n";
+    s += "          " +
+         getXdmfDataItem(h5_filename, "/" + path + "/PointData/Displacement",
+                         node_dims) +
+         "\n";
+    s += "        </DataItem>\n";
+  } else
+    s += "        " + nodes_item + "\n";
+  s += "      </Geometry>\n";
+
+  // static data and data of step
+  std::vector<std::pair<std::string, std::string>> groups = {
+      {"Static", "Node"},
+      {path + "/PointData", "Node"},
+      {path + "/CellData", "Cell"}};
+  for (const auto &group : groups)
+    for (const auto &name : getNames(file, group.first)) {
+      auto dims = getDims(file, group.first + "/" + name);
+      s += "      <Attribute Name=\"" + name + "\" AttributeType=\"" +
+           getXdmfAttributeType(dims[1]) + "\" Center=\"" + group.second +
+           "\">\n        " +
+           getXdmfDataItem(h5_filename, "/" + group.first + "/" + name, dims) +
+           "\n      </Attribute>\n";
+    }
+
+  s += "    </Grid>\n";
+  return s;
+}
+
+/*! @brief Flattens the vector data into row major array */
+std::vector<double> flatten(const std::vector<util::Point3> *data) {
+  std::vector<double> d(3 * data->size());
+  for (size_t i = 0; i < data->size(); i++) {
+    d[3 * i] = (*data)[i].d_x;
+    d[3 * i + 1] = (*data)[i].d_y;
+    d[3 * i + 2] = (*data)[i].d_z;
+  }
+  return d;
+}
+
+/*! @brief Flattens the symmetric matrix data into row major array in order
+ * xx, yy, zz, yz, xz, xy */
+std::vector<double> flatten(const std::vector<util::SymMatrix3> *data) {
+  std::vector<double> d(6 * data->size());
+  for (size_t i = 0; i < data->size(); i++) {
+    const auto &m = (*data)[i];
+    d[6 * i] = m(0, 0);
+    d[6 * i + 1] = m(1, 1);
+    d[6 * i + 2] = m(2, 2);
+    d[6 * i + 3] = m(1, 2);
+    d[6 * i + 4] = m(0, 2);
+    d[6 * i + 5] = m(0, 1);
+  }
+  return d;
+}
+
+} // namespace
+
+rw::writer::Hdf5Writer::Hdf5Writer(const std::string &filename,
+                                   const std::string &compress_type)
+    : d_compressType(compress_type), d_rewriteXdmf(false), d_file(-1),
+      d_stepGroup(-1) {
+
+  // split filename path/name_N into path/name and name_N
+  auto pos = filename.find_last_of('/');
+  auto dir = pos == std::string::npos ? "" : filename.substr(0, pos + 1);
+  d_stepName = pos == std::string::npos ? filename : filename.substr(pos + 1);
+
+  auto base = d_stepName;
+  bool first_step = true;
+  auto u = base.find_last_of('_');
+  if (u != std::string::npos && u + 1 < base.size() &&
+      base.find_first_not_of("0123456789", u + 1) == std::string::npos) {
+    first_step = std::stoul(base.substr(u + 1)) == 0;
+    base = base.substr(0, u);
+  }
+  d_filename = dir + base;
+
+  // first output of a simulation creates new file (data of earlier run is
+  // discarded) and later output steps, e.g. also after restart, are added
+  // to the existing file
+  std::string h5_filename = d_filename + ".h5";
+  if (!first_step && std::ifstream(h5_filename) &&
+      H5Fis_hdf5(h5_filename.c_str()) > 0)
+    d_file = H5Fopen(h5_filename.c_str(), H5F_ACC_RDWR, H5P_DEFAULT);
+  else {
+    d_file = H5Fcreate(h5_filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT,
+                       H5P_DEFAULT);
+    d_rewriteXdmf = true;
+  }
+
+  if (d_file < 0) {
+    std::cerr << "Error: Can not open file = " << h5_filename << ".\n";
+    exit(1);
+  }
+
+  // create group for this step (if the step exists from earlier run, we
+  // replace it and the XDMF file needs to be written again)
+  auto steps = openGroup(d_file, "Steps");
+  if (linkExists(steps, d_stepName)) {
+    H5Ldelete(steps, d_stepName.c_str(), H5P_DEFAULT);
+    d_rewriteXdmf = true;
+  }
+  d_stepGroup = H5Gcreate2(steps, d_stepName.c_str(), H5P_DEFAULT,
+                           H5P_DEFAULT, H5P_DEFAULT);
+  H5Gclose(openGroup(d_stepGroup, "PointData"));
+  H5Gclose(openGroup(d_stepGroup, "CellData"));
+  H5Gclose(steps);
+}
+
+void rw::writer::Hdf5Writer::appendNodes(
+    const std::vector<util::Point3> *nodes,
+    const std::vector<util::Point3> *u) {
+  bool compress = d_compressType == "zlib";
+
+  // if the number of nodes has changed, the file holds the mesh of different
+  // simulation and we replace the mesh and static data
+  if (linkExists(d_file, "Mesh") && linkExists(d_file, "Mesh/Nodes") &&
+      getDims(d_file, "Mesh/Nodes")[0] != nodes->size()) {
+    H5Ldelete(d_file, "Mesh", H5P_DEFAULT);
+    if (linkExists(d_file, "Static")) H5Ldelete(d_file, "Static", H5P_DEFAULT);
+
+    // steps of earlier simulation do not match the new mesh
+    for (const auto &name : getNames(d_file, "Steps"))
+      if (name != d_stepName)
+        H5Ldelete(d_file, ("Steps/" + name).c_str(), H5P_DEFAULT);
+    d_rewriteXdmf = true;
+  }
+
+  // reference position of nodes is written only once
+  auto mesh = openGroup(d_file, "Mesh");
+  if (!linkExists(mesh, "Nodes")) {
+    auto x = flatten(nodes);
+    writeDataset(mesh, "Nodes", H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, x.data(),
+                 nodes->size(), 3, compress);
+  }
+  H5Gclose(mesh);
+
+  // displacement gives the current position of nodes in this step
+  if (u) {
+    auto x = flatten(u);
+    writePointData("Displacement", x, u->size(), 3);
+  }
+}
+
+void rw::writer::Hdf5Writer::appendMesh(const std::vector<util::Point3> *nodes,
+                                        const size_t &element_type,
+                                        const std::vector<size_t> *en_con,
+                                        const std::vector<util::Point3> *u) {
+  appendNodes(nodes, u);
+
+  // element-node connectivity is written only once
+  auto mesh = openGroup(d_file, "Mesh");
+  if (!linkExists(mesh, "Connectivity")) {
+    size_t num_vertex = util::vtk_map_element_to_num_nodes[element_type];
+    size_t num_elems = en_con->size() / num_vertex;
+
+    std::vector<uint64_t> con(en_con->begin(), en_con->end());
+    writeDataset(mesh, "Connectivity", H5T_NATIVE_UINT64, H5T_STD_U64LE,
+                 con.data(), num_elems, num_vertex,
+                 d_compressType == "zlib");
+    writeAttribute(mesh, "Element_Type", double(element_type));
+  }
+  H5Gclose(mesh);
+}
+
+void rw::writer::Hdf5Writer::writePointData(const std::string &name,
+                                            const std::vector<double> &data,
+                                            size_t rows, size_t cols) {
+  bool compress = d_compressType == "zlib";
+
+  // data is written only once per step (e.g. displacement is written with
+  // the nodes and may be appended again as point data)
+  if (std::find(d_pointData.begin(), d_pointData.end(), name) !=
+      d_pointData.end())
+    return;
+  d_pointData.push_back(name);
+
+  if (std::find(static_point_data.begin(), static_point_data.end(), name) !=
+      static_point_data.end()) {
+    auto group = openGroup(d_file, "Static");
+    if (!linkExists(group, name))
+      writeDataset(group, name, H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, data.data(),
+                   rows, cols, compress);
+    H5Gclose(group);
+    return;
+  }
+
+  auto group = openGroup(d_stepGroup, "PointData");
+  writeDataset(group, name, H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, data.data(),
+               rows, cols, compress);
+  H5Gclose(group);
+}
+
+void rw::writer::Hdf5Writer::writeCellData(const std::string &name,
+                                           const std::vector<double> &data,
+                                           size_t rows, size_t cols) {
+  auto group = openGroup(d_stepGroup, "CellData");
+  writeDataset(group, name, H5T_NATIVE_DOUBLE, H5T_IEEE_F64LE, data.data(),
+               rows, cols, d_compressType == "zlib");
+  H5Gclose(group);
+}
+
+template <class T>
+void rw::writer::Hdf5Writer::writeScalarPointData(const std::string &name,
+                                                  const std::vector<T> *data) {
+  std::vector<double> d(data->begin(), data->end());
+  writePointData(name, d, d.size(), 1);
+}
+
+void rw::writer::Hdf5Writer::appendPointData(const std::string &name,
+                                             const std::vector<uint8_t> *data) {
+  writeScalarPointData(name, data);
+}
+
+void rw::writer::Hdf5Writer::appendPointData(const std::string &name,
+                                             const std::vector<size_t> *data) {
+  writeScalarPointData(name, data);
+}
+
+void rw::writer::Hdf5Writer::appendPointData(const std::string &name,
+                                             const std::vector<int> *data) {
+  writeScalarPointData(name, data);
+}
+
+void rw::writer::Hdf5Writer::appendPointData(const std::string &name,
+                                             const std::vector<float> *data) {
+  writeScalarPointData(name, data);
+}
+
+void rw::writer::Hdf5Writer::appendPointData(const std::string &name,
+                                             const std::vector<double> *data) {
+  writePointData(name, *data, data->size(), 1);
+}
+
+void rw::writer::Hdf5Writer::appendPointData(
+    const std::string &name, const std::vector<util::Point3> *data) {
+  writePointData(name, flatten(data), data->size(), 3);
+}
+
+void rw::writer::Hdf5Writer::appendPointData(
+    const std::string &name, const std::vector<util::SymMatrix3> *data) {
+  writePointData(name, flatten(data), data->size(), 6);
+}
+
+void rw::writer::Hdf5Writer::appendCellData(const std::string &name,
+                                            const std::vector<float> *data) {
+  std::vector<double> d(data->begin(), data->end());
+  writeCellData(name, d, d.size(), 1);
+}
+
+void rw::writer::Hdf5Writer::appendCellData(
+    const std::string &name, const std::vector<util::SymMatrix3> *data) {
+  writeCellData(name, flatten(data), data->size(), 6);
+}
+
+void rw::writer::Hdf5Writer::appendFieldData(const std::string &name,
+                                             const double &data) {
+  writeAttribute(d_stepGroup, name, data);
+}
+
+void rw::writer::Hdf5Writer::appendFieldData(const std::string &name,
+                                             const float &data) {
+  writeAttribute(d_stepGroup, name, double(data));
+}
+
+void rw::writer::Hdf5Writer::addTimeStep(const double &timestep) {
+  writeAttribute(d_stepGroup, "Time", timestep);
+}
+
+void rw::writer::Hdf5Writer::close() {
+  if (d_file < 0) return;
+
+  H5Gclose(d_stepGroup);
+  writeXdmf();
+  H5Fclose(d_file);
+  d_stepGroup = -1;
+  d_file = -1;
+}
+
+void rw::writer::Hdf5Writer::writeXdmf() {
+  if (!linkExists(d_file, "Mesh") || !linkExists(d_file, "Mesh/Nodes")) return;
+
+  // HDF5 file is referred relative to XDMF file
+  auto h5_filename = d_filename.substr(d_filename.find_last_of('/') + 1) + ".h5";
+  std::string fname = d_filename + ".xmf";
+
+  // append grid of this step before the closing tags of existing XDMF file
+  if (!d_rewriteXdmf) {
+    FILE *fout = fopen(fname.c_str(), "r+");
+    if (fout) {
+      std::string footer(xdmf_footer.size(), '\0');
+      long pos = -1;
+      if (fseek(fout, -long(xdmf_footer.size()), SEEK_END) == 0) {
+        pos = ftell(fout);
+        if (fread(&footer[0], 1, footer.size(), fout) != footer.size())
+          pos = -1;
+      }
+
+      if (pos >= 0 && footer == xdmf_footer) {
+        auto group = H5Gopen2(d_file, ("Steps/" + d_stepName).c_str(),
+                              H5P_DEFAULT);
+        auto time = readAttribute(group, "Time");
+        H5Gclose(group);
+
+        fseek(fout, pos, SEEK_SET);
+        fprintf(fout, "%s%s",
+                getXdmfGrid(d_file, h5_filename, d_stepName, time).c_str(),
+                xdmf_footer.c_str());
+        fclose(fout);
+        return;
+      }
+      fclose(fout);
+    }
+  }
+
+  // write all steps sorted by time
+  std::vector<std::pair<double, std::string>> steps;
+  for (const auto &name : getNames(d_file, "Steps")) {
+    auto group = H5Gopen2(d_file, ("Steps/" + name).c_str(), H5P_DEFAULT);
+    steps.emplace_back(readAttribute(group, "Time"), name);
+    H5Gclose(group);
+  }
+  std::stable_sort(steps.begin(), steps.end(),
+                   [](const std::pair<double, std::string> &a,
+                      const std::pair<double, std::string> &b) {
+                     return a.first < b.first;
+                   });
+
+  FILE *fout = fopen(fname.c_str(), "w");
+  if (!fout) {
+    std::cerr << "Error: Can not open file = " << fname << ".\n";
+    exit(1);
+  }
+
+  fprintf(fout, "<?xml version=\"1.0\" ?>\n");
+  fprintf(fout, "<Xdmf Version=\"3.0\">\n");
+  fprintf(fout, "  <Domain>\n");
+  fprintf(fout, "    <Grid Name=\"TimeSeries\" GridType=\"Collection\" "
+                "CollectionType=\"Temporal\">\n");
+  for (const auto &step : steps)
+    fprintf(fout, "%s",
+            getXdmfGrid(d_file, h5_filename, step.second, step.first)
+                .c_str());
+  fprintf(fout, "%s", xdmf_footer.c_str());
+  fclose(fout);
+}
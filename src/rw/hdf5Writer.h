@@ -0,0 +1,266 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef RW_HDF5WRITER_H
+#define RW_HDF5WRITER_H
+
+#include "util/matrix.h" // definition of SymMatrix3
+#include "util/point.h"  // definition of Point3
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace rw {
+
+namespace writer {
+
+/*! @brief A time series writer based on HDF5 and XDMF
+ *
+ * All output steps of a simulation are written to a single HDF5 file. If the
+ * filename is of the form path/name_N, the data is written to path/name.h5
+ * in group /Steps/name_N and the XDMF descriptor path/name.xmf, which can be
+ * opened in ParaView or VisIt, is updated when the writer is closed. The grid
+ * of the step is appended to the XDMF file; the file is written again from
+ * all steps only if it does not exist or if a step or the mesh is replaced.
+ *
+ * The first output step name_0 (or a filename without step number) creates
+ * a new file and discards data of an earlier simulation. Later steps, also
+ * of a restarted simulation, are added to the existing file.
+ *
+ * Data which does not change during the simulation is written only once:
+ * - reference position of nodes in /Mesh/Nodes
+ * - element-node connectivity in /Mesh/Connectivity
+ * - point data Fixity, Node_Volume and Neighbors in /Static
+ *
+ * Every step writes point and cell data into groups PointData and CellData
+ * of the step group and time and field data as attributes of the step group.
+ * Datasets are chunked and, if compression type is "zlib", compressed with
+ * deflate.
+ */
+class Hdf5Writer {
+
+public:
+  /*!
+   * @brief Constructor
+   *
+   * Opens (or creates) the HDF5 file of the simulation and creates the group
+   * for this output step. The file remains open till the close() function is
+   * invoked.
+   *
+   * @param filename Name of output step, e.g. path/output_N
+   * @param compress_type Compression method (optional)
+   */
+  explicit Hdf5Writer(const std::string &filename,
+                      const std::string &compress_type = "");
+
+  /**
+   * @name Mesh data
+   */
+  /**@{*/
+
+  /*!
+   * @brief Writes the nodes to the file
+   * @param nodes Reference positions of the nodes
+   * @param u Nodal displacements
+   */
+  void appendNodes(const std::vector<util::Point3> *nodes,
+                   const std::vector<util::Point3> *u = nullptr);
+
+  /*!
+   * @brief Writes the mesh data to file
+   *
+   * @param nodes Vector of nodal coordinates
+   * @param element_type Type of element
+   * @param en_con Vector of element-node connectivity
+   * @param u Vector of nodal displacement
+   */
+  void appendMesh(const std::vector<util::Point3> *nodes,
+                  const size_t &element_type,
+                  const std::vector<size_t> *en_con,
+                  const std::vector<util::Point3> *u = nullptr);
+
+  /** @}*/
+
+  /**
+   * @name Point data
+   */
+  /**@{*/
+
+  /*!
+   * @brief Writes the scalar point data to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendPointData(const std::string &name,
+                       const std::vector<uint8_t> *data);
+
+  /*!
+   * @brief Writes the scalar point data to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendPointData(const std::string &name,
+                       const std::vector<size_t> *data);
+
+  /*!
+   * @brief Writes the scalar point data to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendPointData(const std::string &name, const std::vector<int> *data);
+
+  /*!
+   * @brief Writes the scalar point data to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendPointData(const std::string &name, const std::vector<float> *data);
+
+  /*!
+   * @brief Writes the scalar point data to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendPointData(const std::string &name,
+                       const std::vector<double> *data);
+
+  /*!
+   * @brief Writes the vector point data to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendPointData(const std::string &name,
+                       const std::vector<util::Point3> *data);
+
+  /*!
+   * @brief Writes the symmetric matrix data associated to nodes to the
+   * file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendPointData(const std::string &name,
+                       const std::vector<util::SymMatrix3> *data);
+
+  /** @}*/
+
+  /**
+   * @name Cell data
+   */
+  /**@{*/
+
+  /*!
+   * @brief Writes the float data associated to cells to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendCellData(const std::string &name, const std::vector<float> *data);
+
+  /*!
+   * @brief Writes the symmetric matrix data associated to cells to the file
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  void appendCellData(const std::string &name,
+                      const std::vector<util::SymMatrix3> *data);
+
+  /** @}*/
+
+  /**
+   * @name Field data
+   */
+  /**@{*/
+
+  /*!
+   * @brief Writes the scalar field data to the file
+   * @param name Name of the data
+   * @param data Value
+   */
+  void appendFieldData(const std::string &name, const double &data);
+
+  /*!
+   * @brief Writes the scalar field data to the file
+   * @param name Name of the data
+   * @param data Value
+   */
+  void appendFieldData(const std::string &name, const float &data);
+
+  /*!
+   * @brief Writes the time step to the file
+   * @param timestep Current time step of the simulation
+   */
+  void addTimeStep(const double &timestep);
+
+  /** @}*/
+
+  /*!
+   * @brief Closes the file and updates the XDMF file
+   */
+  void close();
+
+private:
+  /*!
+   * @brief Writes scalar point data
+   * @param name Name of the data
+   * @param data Vector containing the data
+   */
+  template <class T>
+  void writeScalarPointData(const std::string &name,
+                            const std::vector<T> *data);
+
+  /*!
+   * @brief Writes point data either in step group or, if the data is
+   * static, in static group (only if not already written)
+   * @param name Name of the data
+   * @param data Data in row major order
+   * @param rows Number of rows
+   * @param cols Number of columns
+   */
+  void writePointData(const std::string &name, const std::vector<double> &data,
+                      size_t rows, size_t cols);
+
+  /*!
+   * @brief Writes cell data in step group
+   * @param name Name of the data
+   * @param data Data in row major order
+   * @param rows Number of rows
+   * @param cols Number of columns
+   */
+  void writeCellData(const std::string &name, const std::vector<double> &data,
+                     size_t rows, size_t cols);
+
+  /*! @brief Appends the step to the XDMF file (or writes the XDMF file
+   * describing all steps in HDF5 file) */
+  void writeXdmf();
+
+  /*! @brief Name of output step */
+  std::string d_stepName;
+
+  /*! @brief Name of HDF5 file and XDMF file without extension */
+  std::string d_filename;
+
+  /*! @brief compression_type Specify the compressor (if any) */
+  std::string d_compressType;
+
+  /*! @brief Names of point data written in this step */
+  std::vector<std::string> d_pointData;
+
+  /*! @brief Flag to write the XDMF file from all steps instead of appending */
+  bool d_rewriteXdmf;
+
+  /*! @brief HDF5 file id */
+  int64_t d_file;
+
+  /*! @brief HDF5 group id of output step */
+  int64_t d_stepGroup;
+};
+
+} // namespace writer
+
+} // namespace rw
+
+#endif // RW_HDF5WRITER_H
@@ -8,435 +8,568 @@
 
 #include "mshReader.h"
 
+#include <algorithm>
+#include <charconv>
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <string_view>
 
 #include "util/feElementDefs.h"
+#include <zlib.h>
 
-rw::reader::MshReader::MshReader(const std::string &filename)
-    : d_filename(filename){};
+namespace {
 
-void rw::reader::MshReader::readMesh(size_t dim,
-                                     std::vector<util::Point3> *nodes,
-                                     size_t &element_type, size_t &num_elems,
-                                     std::vector<size_t> *enc,
-                                     std::vector<std::vector<size_t>> *nec,
-                                     std::vector<double> *volumes, bool is_fd) {
-  std::ifstream filein(d_filename);
+/*! @brief Moves the cursor past white spaces */
+inline void skipSpace(const char *&p, const char *end) {
+  while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t'))
+    p++;
+}
 
-  // open file
-  if (!d_file) d_file.open(d_filename);
+/*! @brief Moves the cursor to the beginning of next line */
+inline void skipLine(const char *&p, const char *end) {
+  while (p < end && *p != '\n') p++;
+  if (p < end) p++;
+}
 
-  if (!d_file) {
-    std::cerr << "Error: Can not open file = " << d_filename + ".msh"
-              << ".\n";
+/*! @brief Reads a number written in ascii */
+template <class T>
+inline T readAscii(const char *&p, const char *end) {
+  skipSpace(p, end);
+  T val = T();
+  auto res = std::from_chars(p, end, val);
+  if (res.ec != std::errc()) {
+    std::cerr << "Error: Can not parse number in .msh file near '"
+              << std::string(p, std::min<size_t>(end - p, 20)) << "'.\n";
     exit(1);
   }
+  p = res.ptr;
+  return val;
+}
 
-  std::string line;
-  int format = 0;
-  int size = 0;
-  double version = 1.0;
+/*! @brief Reads a number written in binary */
+template <class T>
+inline T readBinary(const char *&p, const char *end) {
+  if (p + sizeof(T) > end) {
+    std::cerr << "Error: Unexpected end of binary .msh file.\n";
+    exit(1);
+  }
+  T val;
+  std::memcpy(&val, p, sizeof(T));
+  p += sizeof(T);
+  return val;
+}
 
-  // clear data
-  nodes->clear();
-  enc->clear();
-  nec->clear();
-  volumes->clear();
+/*! @brief Reads a number written either in ascii or in binary */
+template <class T>
+inline T readValue(const char *&p, const char *end, bool binary) {
+  return binary ? readBinary<T>(p, end) : readAscii<T>(p, end);
+}
 
-  // specify type of element to read
-  if (dim != 2 and dim != 3) {
-    std::cerr << "Error: MshReader currently only supports reading of "
-                 "triangle/quadrangle elements in dimension 2 and tetragonal "
-                 "elements in 3.\n";
+/*! @brief Reads rest of the line and removes quotes around it if any */
+std::string readQuotedLine(const char *&p, const char *end) {
+  skipSpace(p, end);
+  auto q = p;
+  while (q < end && *q != '\n' && *q != '\r') q++;
+  std::string s(p, q);
+  p = q;
+  skipLine(p, end);
+
+  if (s.size() >= 2 && s.front() == '"' && s.back() == '"')
+    s = s.substr(1, s.size() - 2);
+  return s;
+}
+
+/*!
+ * @brief Moves the cursor past the next section tag ($Name) and returns the
+ * name of section
+ *
+ * Empty string is returned if there is no section left.
+ */
+std::string nextSection(const char *&p, const char *end) {
+  skipSpace(p, end);
+  while (p < end && *p != '$') {
+    skipLine(p, end);
+    skipSpace(p, end);
+  }
+  if (p >= end) return "";
+
+  auto q = p + 1;
+  while (q < end && *q != ' ' && *q != '\n' && *q != '\r' && *q != '\t') q++;
+  std::string name(p + 1, q);
+  p = q;
+  skipLine(p, end);
+  return name;
+}
+
+/*! @brief Moves the cursor past the end tag ($EndName) of section */
+void skipSection(const std::string &name, const char *&p, const char *end) {
+  std::string tag = "$End" + name;
+  auto pos = std::string_view(p, end - p).find(tag);
+  if (pos == std::string_view::npos) {
+    std::cerr << "Error: Section $" << name
+              << " in .msh file does not have end tag " << tag << ".\n";
     exit(1);
   }
+  p += pos + tag.size();
+  skipLine(p, end);
+}
 
-  unsigned int num_nodes_con = 0;
-  bool read_nodes = false;
-  bool read_elements = false;
+/*! @brief Converts 1-based msh node tag to index */
+inline size_t nodeIndex(size_t tag, size_t num_nodes) {
+  if (tag < 1 || tag > num_nodes) {
+    std::cerr << "Error: Node tag = " << tag
+              << " in .msh file is outside the range [1, " << num_nodes
+              << "]. Node tags must be numbered continuously.\n";
+    exit(1);
+  }
+  return tag - 1;
+}
 
-  while (true) {
-    std::getline(filein, line);
-    if (filein) {
-      // // read $MeshFormat block
-      if (line.find("$MeshFormat") == static_cast<std::string::size_type>(0)) {
-        filein >> version >> format >> size;
-        if ((version != 2.0) && (version != 2.1) && (version != 2.2)) {
-          std::cerr << "Error: Unknown .msh file version " << version << "\n";
-          exit(1);
-        }
+/*!
+ * @brief Checks if element of msh type is read for given dimension and
+ * returns the number of vertices of element (0 if element is not read)
+ */
+size_t selectElement(size_t dim, size_t type, size_t &element_type,
+                     bool &found_tri, bool &found_quad) {
+  if (type == util::msh_type_triangle and dim == 2) {
+    found_tri = true;
+    element_type = util::vtk_type_triangle;
+    return util::msh_map_element_to_num_nodes[util::msh_type_triangle];
+  } else if (type == util::msh_type_quadrangle and dim == 2) {
+    found_quad = true;
+    element_type = util::vtk_type_quad;
+    return util::msh_map_element_to_num_nodes[util::msh_type_quadrangle];
+  } else if (type == util::msh_type_tetrahedron and dim == 3) {
+    element_type = util::vtk_type_tetra;
+    return util::msh_map_element_to_num_nodes[util::msh_type_tetrahedron];
+  }
 
-        // we only support reading of ascii format, so issue error if this
-        // condition is not met
-        if (format) {
-          std::cerr << "Error: Format of .msh is possibly binary which is not"
-                       " supported currently.\n ";
-          exit(1);
-        }
-      }
-      // read $Nodes block
-      if (line.find("$NOD") == static_cast<std::string::size_type>(0) ||
-          line.find("$NOE") == static_cast<std::string::size_type>(0) ||
-          line.find("$Nodes") == static_cast<std::string::size_type>(0)) {
-        read_nodes = true;
-        unsigned int num_nodes = 0;
-        filein >> num_nodes;
-
-        // allocate space
-        nodes->resize(num_nodes);
-        nec->resize(num_nodes);
-
-        // read in the nodal coordinates and form points.
-        double x, y, z;
-        unsigned int id;
-
-        // add the nodal coordinates to the filein
-        for (unsigned int i = 0; i < num_nodes; ++i) {
-          filein >> id >> x >> y >> z;
-          (*nodes)[id - 1] = util::Point3(x, y, z);
-        }
-        // read the $ENDNOD delimiter
-        std::getline(filein, line);
-      }  // end of reading nodes
-         // Read the element block
-      else if (line.find("$ELM") == static_cast<std::string::size_type>(0) ||
-               line.find("$Elements") ==
-                   static_cast<std::string::size_type>(0)) {
-        read_elements = true;
-
-        // For reading the number of elements and the node ids from the stream
-        unsigned int num_elem = 0;
-        unsigned int node_id = 0;
-
-        // read how many elements are there
-        // this includes point element, line element also
-        filein >> num_elem;
-
-        // As of version 2.2, the format for each element line is:
-        // elm-number elm-type number-of-tags < tag > ... node-number-list
-
-        // read the elements
-        size_t elem_counter = 0;
-        bool found_tri = false;
-        bool found_quad = false;
-        bool found_tet = false;
-        for (unsigned int iel = 0; iel < num_elem; ++iel) {
-          unsigned int id;
-          unsigned int type;
-          unsigned int ntags;
-          int tag;
-          filein >> id >> type >> ntags;
-          for (unsigned int j = 0; j < ntags; j++) filein >> tag;
-
-          // we will read only those elements which we support
-          bool read_this_element = false;
-
-          // read element type we desire and for other element type
-          // perform dummy read
-          if (type == util::msh_type_triangle and dim == 2) {
-            read_this_element = true;
-            found_tri = true;
-            element_type = util::vtk_type_triangle;
-            num_nodes_con =
-                util::msh_map_element_to_num_nodes[util::msh_type_triangle];
-          } else if (type == util::msh_type_quadrangle and dim == 2) {
-            read_this_element = true;
-            found_quad = true;
-            element_type = util::vtk_type_quad;
-            num_nodes_con =
-                util::msh_map_element_to_num_nodes[util::msh_type_quadrangle];
-          } else if (type == util::msh_type_tetrahedron and dim == 3) {
-            read_this_element = true;
-            found_tet = true;
-            element_type = util::vtk_type_tetra;
-            num_nodes_con =
-                util::msh_map_element_to_num_nodes[util::msh_type_tetrahedron];
-          }
+  return 0;
+}
 
-          // std::vector<size_t> e_nodes;
-          if (read_this_element) {
-            // read vertex of this element
-            for (unsigned int i = 0; i < num_nodes_con; i++) {
-              filein >> node_id;
-              // add to the element-node connectivity
-              // substract 1 to correct the numbering convention
-              enc->push_back(node_id - 1);
-
-              // e_nodes.push_back(node_id - 1);
-
-              // fill the node-element connectivity table
-              (*nec)[node_id - 1].push_back(elem_counter);
-            }
-
-            // debug
-            //            std::cout << "(" << id << ", " << type << ", " <<
-            //            elem_counter
-            //                      << ") = ";
-            //            for (auto enode: e_nodes)
-            //              std::cout << enode << ";";
-            //            std::cout << "\n";
-
-            // increment the element counter
-            elem_counter++;
-          } else {
-            // these are the type of elements we need to ignore.
-            size_t n = util::msh_map_element_to_num_nodes[type];
-            // dummy read
-            for (unsigned int i = 0; i < n; i++) filein >> node_id;
-          }
-        }  // element loop
-
-        // check if mesh contains both triangle and quadrangle elements
-        if (found_quad and found_tri) {
-          std::cerr << "Error: Check mesh file. It appears to have both "
-                       "quadrangle elements and triangle elements. "
-                       "Currently we only support one kind of elements.\n";
-          exit(1);
-        }
+/*! @brief Returns number of vertices of msh element type */
+inline size_t mshElementNumNodes(size_t type) {
+  if (type >= 16 || util::msh_map_element_to_num_nodes[type] == 0) {
+    std::cerr << "Error: Element type = " << type
+              << " in binary .msh file is not supported.\n";
+    exit(1);
+  }
+  return util::msh_map_element_to_num_nodes[type];
+}
 
-        // write the number of elements
-        num_elems = elem_counter;
+} // namespace
 
-        // read the $ENDELM delimiter
-        std::getline(filein, line);
-      }  // end of reading elements
-    }    // if filein
+rw::reader::MshReader::MshReader(const std::string &filename)
+    : d_filename(filename), d_dataStart(0), d_version(0.), d_binary(false){};
 
-    // If !filein, check to see if EOF was set.  If so, break out
-    // of while loop.
-    if (filein.eof()) break;
+void rw::reader::MshReader::open() {
+  if (!d_buffer.empty()) return;
 
-    if (read_nodes and read_elements) break;
+  // file may have been written compressed (see MshWriter) in which case
+  // extension .gz is appended to the filename
+  std::string filename = d_filename;
+  if (!std::ifstream(filename) && std::ifstream(filename + ".gz"))
+    filename += ".gz";
 
-    // If !filein and !filein.eof(), stream is in a bad state!
-    // std::cerr<<"Error: Stream is bad! Perhaps the file does not exist?\n";
-    // exit(1);
-  }  // while true
+  // read complete file in one go
+  std::ifstream file(filename, std::ios::binary | std::ios::ate);
+  if (!file) {
+    std::cerr << "Error: Can not open file = " << d_filename << ".\n";
+    exit(1);
+  }
+  auto size = file.tellg();
+  d_buffer.resize(size_t(size));
+  file.seekg(0);
+  file.read(&d_buffer[0], size);
+  file.close();
+
+  // decompress if file is gzip compressed
+  if (d_buffer.size() > 2 && (unsigned char)(d_buffer[0]) == 0x1f &&
+      (unsigned char)(d_buffer[1]) == 0x8b) {
+    d_buffer.clear();
+    gzFile gz = gzopen(filename.c_str(), "rb");
+    char buf[1 << 16];
+    int n = 0;
+    while ((n = gzread(gz, buf, sizeof(buf))) > 0) d_buffer.append(buf, n);
+    gzclose(gz);
+    if (n < 0) {
+      std::cerr << "Error: Can not decompress file = " << filename << ".\n";
+      exit(1);
+    }
+  }
 
-  // close file
-  filein.close();
-}
+  const char *p = d_buffer.data();
+  const char *end = p + d_buffer.size();
 
-void rw::reader::MshReader::readNodes(std::vector<util::Point3> *nodes) {
-  // open file
-  if (!d_file) d_file = std::ifstream(d_filename);
+  // read $MeshFormat block
+  if (nextSection(p, end) != "MeshFormat") {
+    std::cerr << "Error: File = " << d_filename
+              << " does not start with $MeshFormat section.\n";
+    exit(1);
+  }
+
+  d_version = readAscii<double>(p, end);
+  int format = readAscii<int>(p, end);
+  int size_data = readAscii<int>(p, end);
+  d_binary = format == 1;
 
-  if (!d_file) {
-    std::cerr << "Error: Can not open file = " << d_filename + ".msh.\n";
+  if ((d_version != 2.0) && (d_version != 2.1) && (d_version != 2.2) &&
+      (d_version != 4.1)) {
+    std::cerr << "Error: Unknown .msh file version " << d_version << "\n";
     exit(1);
   }
 
-  std::string line;
-  int format = 0;
-  int size = 0;
-  double version = 1.0;
+  if (d_binary) {
+    if (size_data != sizeof(double) ||
+        (d_version > 4. && size_data != sizeof(size_t))) {
+      std::cerr << "Error: Data size = " << size_data
+                << " in binary .msh file is not supported.\n";
+      exit(1);
+    }
 
-  // clear data
-  nodes->clear();
-  bool read_nodes = false;
+    // binary file has integer 1 written after the format line which is used
+    // to detect the endianness
+    skipLine(p, end);
+    if (readBinary<int>(p, end) != 1) {
+      std::cerr << "Error: Binary .msh file is written with different "
+                   "endianness.\n";
+      exit(1);
+    }
+  }
 
-  while (true) {
-    std::getline(d_file, line);
-    if (d_file) {
-      // // read $MeshFormat block
-      if (line.find("$MeshFormat") == static_cast<std::string::size_type>(0)) {
-        d_file >> version >> format >> size;
-        if ((version != 2.0) && (version != 2.1) && (version != 2.2)) {
-          std::cerr << "Error: Unknown .msh file version " << version << "\n";
-          exit(1);
+  skipSection("MeshFormat", p, end);
+  d_dataStart = size_t(p - d_buffer.data());
+}
+
+void rw::reader::MshReader::readNodesSection(const char *&p,
+                                             std::vector<util::Point3> *nodes) {
+  const char *end = d_buffer.data() + d_buffer.size();
+
+  if (d_version < 4.) {
+    // in version 2 number of nodes is written in ascii also in binary format
+    auto num_nodes = readAscii<size_t>(p, end);
+    if (d_binary) skipLine(p, end);
+
+    nodes->resize(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++) {
+      size_t id = d_binary ? size_t(readBinary<int>(p, end))
+                           : readAscii<size_t>(p, end);
+      auto x = readValue<double>(p, end, d_binary);
+      auto y = readValue<double>(p, end, d_binary);
+      auto z = readValue<double>(p, end, d_binary);
+      (*nodes)[nodeIndex(id, num_nodes)] = util::Point3(x, y, z);
+    }
+  } else {
+    auto num_blocks = readValue<size_t>(p, end, d_binary);
+    auto num_nodes = readValue<size_t>(p, end, d_binary);
+    readValue<size_t>(p, end, d_binary);
+    readValue<size_t>(p, end, d_binary);
+
+    nodes->resize(num_nodes);
+    std::vector<size_t> tags;
+    for (size_t b = 0; b < num_blocks; b++) {
+      auto entity_dim = readValue<int>(p, end, d_binary);
+      readValue<int>(p, end, d_binary);
+      auto parametric = readValue<int>(p, end, d_binary);
+      auto n = readValue<size_t>(p, end, d_binary);
+      size_t num_param = parametric ? size_t(entity_dim) : 0;
+
+      // node tags of block are followed by their coordinates
+      tags.resize(n);
+      for (size_t i = 0; i < n; i++)
+        tags[i] = readValue<size_t>(p, end, d_binary);
+
+      for (size_t i = 0; i < n; i++) {
+        auto x = readValue<double>(p, end, d_binary);
+        auto y = readValue<double>(p, end, d_binary);
+        auto z = readValue<double>(p, end, d_binary);
+        for (size_t j = 0; j < num_param; j++)
+          readValue<double>(p, end, d_binary);
+        (*nodes)[nodeIndex(tags[i], num_nodes)] = util::Point3(x, y, z);
+      }
+    }
+  }
+
+  skipSection("Nodes", p, end);
+}
+
+void rw::reader::MshReader::readElementsSection(
+    const char *&p, size_t dim, size_t &element_type, size_t &num_elems,
+    std::vector<size_t> *enc, std::vector<std::vector<size_t>> *nec) {
+  const char *end = d_buffer.data() + d_buffer.size();
+  size_t num_nodes = nec->size();
+
+  size_t elem_counter = 0;
+  bool found_tri = false;
+  bool found_quad = false;
+
+  // adds vertices of element to the element-node and node-element
+  // connectivity
+  auto add_vertex = [&](size_t node_tag) {
+    auto n = nodeIndex(node_tag, num_nodes);
+    enc->push_back(n);
+    (*nec)[n].push_back(elem_counter);
+  };
+
+  if (d_version < 4.) {
+    // As of version 2.2, the format for each element line is:
+    // elm-number elm-type number-of-tags < tag > ... node-number-list
+    auto num_elem = readAscii<size_t>(p, end);
+
+    if (!d_binary) {
+      for (size_t iel = 0; iel < num_elem; iel++) {
+        readAscii<size_t>(p, end);
+        auto type = readAscii<size_t>(p, end);
+        auto ntags = readAscii<size_t>(p, end);
+        for (size_t j = 0; j < ntags; j++) readAscii<long>(p, end);
+
+        auto nv = selectElement(dim, type, element_type, found_tri, found_quad);
+        if (nv > 0) {
+          for (size_t i = 0; i < nv; i++) add_vertex(readAscii<size_t>(p, end));
+          elem_counter++;
         }
 
-        // we only support reading of ascii format, so issue error if this
-        // condition is not met
-        if (format) {
-          std::cerr << "Error: Format of .msh is possibly binary which is not"
-                       " supported currently.\n ";
-          exit(1);
+        // move to next element (also skips the element we do not read)
+        skipLine(p, end);
+      }
+    } else {
+      // elements in binary are written in blocks of same type with header
+      // elm-type num-elm-follow num-tags
+      skipLine(p, end);
+      size_t iel = 0;
+      while (iel < num_elem) {
+        auto type = size_t(readBinary<int>(p, end));
+        auto num_follow = size_t(readBinary<int>(p, end));
+        auto ntags = size_t(readBinary<int>(p, end));
+        auto nv_type = mshElementNumNodes(type);
+        auto nv = selectElement(dim, type, element_type, found_tri, found_quad);
+
+        for (size_t k = 0; k < num_follow; k++) {
+          // element id and tags
+          p += sizeof(int) * (1 + ntags);
+          if (nv > 0) {
+            for (size_t i = 0; i < nv; i++)
+              add_vertex(size_t(readBinary<int>(p, end)));
+            elem_counter++;
+          } else
+            p += sizeof(int) * nv_type;
         }
+        iel += num_follow;
       }
-      // read $Nodes block
-      if (line.find("$NOD") == static_cast<std::string::size_type>(0) ||
-          line.find("$NOE") == static_cast<std::string::size_type>(0) ||
-          line.find("$Nodes") == static_cast<std::string::size_type>(0)) {
-        read_nodes = true;
-        unsigned int num_nodes = 0;
-        d_file >> num_nodes;
-
-        // allocate space
-        nodes->resize(num_nodes);
-
-        // read in the nodal coordinates and form points.
-        double x, y, z;
-        unsigned int id;
-
-        // add the nodal coordinates to the d_file
-        for (unsigned int i = 0; i < num_nodes; ++i) {
-          d_file >> id >> x >> y >> z;
-          (*nodes)[id - 1] = util::Point3(x, y, z);
+    }
+  } else {
+    auto num_blocks = readValue<size_t>(p, end, d_binary);
+    readValue<size_t>(p, end, d_binary);
+    readValue<size_t>(p, end, d_binary);
+    readValue<size_t>(p, end, d_binary);
+
+    for (size_t b = 0; b < num_blocks; b++) {
+      readValue<int>(p, end, d_binary);
+      readValue<int>(p, end, d_binary);
+      auto type = size_t(readValue<int>(p, end, d_binary));
+      auto n = readValue<size_t>(p, end, d_binary);
+      auto nv = selectElement(dim, type, element_type, found_tri, found_quad);
+
+      if (!d_binary) {
+        skipLine(p, end);
+        for (size_t k = 0; k < n; k++) {
+          if (nv > 0) {
+            readAscii<size_t>(p, end);
+            for (size_t i = 0; i < nv; i++)
+              add_vertex(readAscii<size_t>(p, end));
+            elem_counter++;
+          }
+          skipLine(p, end);
+        }
+      } else {
+        auto nv_type = mshElementNumNodes(type);
+        for (size_t k = 0; k < n; k++) {
+          p += sizeof(size_t);
+          if (nv > 0) {
+            for (size_t i = 0; i < nv; i++)
+              add_vertex(readBinary<size_t>(p, end));
+            elem_counter++;
+          } else
+            p += sizeof(size_t) * nv_type;
         }
-        // read the $ENDNOD delimiter
-        std::getline(d_file, line);
-      }  // end of reading nodes
-    }    // if d_file
+      }
+    }
+  }
 
-    // If !d_file, check to see if EOF was set.  If so, break out
-    // of while loop.
-    if (d_file.eof()) break;
+  if (p > end) {
+    std::cerr << "Error: Unexpected end of binary .msh file.\n";
+    exit(1);
+  }
 
-    if (read_nodes) break;
+  // check if mesh contains both triangle and quadrangle elements
+  if (found_quad and found_tri) {
+    std::cerr << "Error: Check mesh file. It appears to have both "
+                 "quadrangle elements and triangle elements. "
+                 "Currently we only support one kind of elements.\n";
+    exit(1);
+  }
 
-    // If !d_file and !d_file.eof(), stream is in a bad state!
-    // std::cerr<<"Error: Stream is bad! Perhaps the file does not exist?\n";
-    // exit(1);
-  }  // while true
+  // write the number of elements
+  num_elems = elem_counter;
 
-  // close file
-  d_file.close();
+  skipSection("Elements", p, end);
 }
 
-bool rw::reader::MshReader::readPointData(const std::string &name,
-                                          std::vector<util::Point3> *data) {
-  // open file
-  if (!d_file) d_file = std::ifstream(d_filename);
+void rw::reader::MshReader::readMesh(size_t dim,
+                                     std::vector<util::Point3> *nodes,
+                                     size_t &element_type, size_t &num_elems,
+                                     std::vector<size_t> *enc,
+                                     std::vector<std::vector<size_t>> *nec,
+                                     std::vector<double> *volumes, bool is_fd) {
+  // specify type of element to read
+  if (dim != 2 and dim != 3) {
+    std::cerr << "Error: MshReader currently only supports reading of "
+                 "triangle/quadrangle elements in dimension 2 and tetragonal "
+                 "elements in 3.\n";
+    exit(1);
+  }
 
-  if (!d_file)
-    if (!d_file) {
-      std::cerr << "Error: Can not open file = " << d_filename + ".msh"
-                << ".\n";
-      exit(1);
-    }
+  open();
+
+  // clear data
+  nodes->clear();
+  enc->clear();
+  nec->clear();
+  volumes->clear();
 
-  bool found_data = false;
-  std::string line;
+  bool read_nodes = false;
+  bool read_elements = false;
+
+  const char *p = d_buffer.data() + d_dataStart;
+  const char *end = d_buffer.data() + d_buffer.size();
+  while (!(read_nodes and read_elements)) {
+    auto section = nextSection(p, end);
+    if (section.empty()) break;
+
+    if (section == "Nodes") {
+      readNodesSection(p, nodes);
+      nec->resize(nodes->size());
+      read_nodes = true;
+    } else if (section == "Elements") {
+      if (!read_nodes) {
+        std::cerr << "Error: $Elements section appears before $Nodes section "
+                     "in file = "
+                  << d_filename << ".\n";
+        exit(1);
+      }
+      readElementsSection(p, dim, element_type, num_elems, enc, nec);
+      read_elements = true;
+    } else
+      skipSection(section, p, end);
+  }
+}
+
+void rw::reader::MshReader::readNodes(std::vector<util::Point3> *nodes) {
+  open();
+
+  // clear data
+  nodes->clear();
+
+  const char *p = d_buffer.data() + d_dataStart;
+  const char *end = d_buffer.data() + d_buffer.size();
   while (true) {
-    std::getline(d_file, line);
-    if (d_file) {
-      // read $Nodes block
-      if (line.find("$NodeData") == static_cast<std::string::size_type>(0)) {
-        // get name of data
-        int num_tags = 0;
-        d_file >> num_tags;
-        std::string tag[num_tags];
-        for (size_t i = 0; i < num_tags; i++) d_file >> tag[i];
-
-        // read dummy data
-        d_file >> num_tags;
-        double real_tag = 0.;
-        d_file >> real_tag;
-
-        int tag_number = 0;
-        int field_type = 0;
-        int num_data = 0;
-        d_file >> tag_number >> field_type >> num_data;
-
-        // check we found the data
-        if (tag[0] == name) {
-          // check if data is of desired field type
-          if (field_type != 3) {
-            std::cerr << "Error: Data " << tag[0] << " is of type "
-                      << field_type << " but we expect it to be of type " << 3
-                      << ".\n";
-            exit(1);
-          }
+    auto section = nextSection(p, end);
+    if (section.empty()) break;
+
+    if (section == "Nodes") {
+      readNodesSection(p, nodes);
+      break;
+    } else
+      skipSection(section, p, end);
+  }
+}
 
-          found_data = true;
-          data->resize(num_data);
-        }
+bool rw::reader::MshReader::readNodeData(const std::string &name,
+                                         int num_comp,
+                                         std::vector<double> *data) {
+  open();
 
-        // we read through the data irrespective of we found it or not
-        for (size_t i = 0; i < num_data; i++) {
-          double d[field_type];
-          for (size_t j = 0; j < field_type; j++) d_file >> d[j];
+  const char *p = d_buffer.data() + d_dataStart;
+  const char *end = d_buffer.data() + d_buffer.size();
+  while (true) {
+    auto section = nextSection(p, end);
+    if (section.empty()) return false;
 
-          if (found_data) (*data)[i] = util::Point3(d[0], d[1], d[2]);
-        }
-        // read the end of data block
-        std::getline(d_file, line);
-      }  // end of reading nodes
-    }    // if d_file
+    if (section != "NodeData") {
+      skipSection(section, p, end);
+      continue;
+    }
 
-    if (found_data) break;
+    // header of data block is in ascii also in binary format
+    auto num_str_tags = readAscii<int>(p, end);
+    skipLine(p, end);
+    std::string tag;
+    for (int i = 0; i < num_str_tags; i++) {
+      auto s = readQuotedLine(p, end);
+      if (i == 0) tag = s;
+    }
 
-    // If !d_file, check to see if EOF was set.  If so, break out
-    // of while loop.
-    if (d_file.eof()) break;
-  }  // while true
+    auto num_real_tags = readAscii<int>(p, end);
+    for (int i = 0; i < num_real_tags; i++) readAscii<double>(p, end);
 
-  d_file.close();
-  return found_data;
-}
+    // integer tags are time step, number of components, number of data
+    auto num_int_tags = readAscii<int>(p, end);
+    std::vector<long> int_tags(num_int_tags);
+    for (int i = 0; i < num_int_tags; i++) int_tags[i] = readAscii<long>(p, end);
 
-bool rw::reader::MshReader::readPointData(const std::string &name,
-                                          std::vector<double> *data) {
-  // open file
-  if (!d_file) d_file = std::ifstream(d_filename);
+    if (tag != name || num_int_tags < 3) {
+      skipSection(section, p, end);
+      continue;
+    }
 
-  if (!d_file)
-    if (!d_file) {
-      std::cerr << "Error: Can not open file = " << d_filename + ".msh"
-                << ".\n";
+    // check if data is of desired field type
+    auto field_type = int(int_tags[1]);
+    auto num_data = size_t(int_tags[2]);
+    if (field_type != num_comp) {
+      std::cerr << "Error: Data " << tag << " is of type " << field_type
+                << " but we expect it to be of type " << num_comp << ".\n";
       exit(1);
     }
 
-  bool found_data = false;
-  std::string line;
-  while (true) {
-    std::getline(d_file, line);
-    if (d_file) {
-      // read $Nodes block
-      if (line.find("$NodeData") == static_cast<std::string::size_type>(0)) {
-        // get name of data
-        int num_tags = 0;
-        d_file >> num_tags;
-        std::string tag[num_tags];
-        for (size_t i = 0; i < num_tags; i++) d_file >> tag[i];
-
-        // read dummy data
-        d_file >> num_tags;
-        double real_tag = 0.;
-        d_file >> real_tag;
-
-        int tag_number = 0;
-        int field_type = 0;
-        int num_data = 0;
-        d_file >> tag_number >> field_type >> num_data;
-
-        // check we found the data
-        if (tag[0] == name) {
-          // check if data is of desired field type
-          if (field_type != 1) {
-            std::cerr << "Error: Data " << tag[0] << " is of type "
-                      << field_type << " but we expect it to be of type " << 1
-                      << ".\n";
-            exit(1);
-          }
-
-          found_data = true;
-          data->resize(num_data);
-        }
+    if (d_binary) skipLine(p, end);
+    data->resize(num_data * num_comp);
+    for (size_t i = 0; i < num_data; i++) {
+      size_t id;
+      if (!d_binary)
+        id = readAscii<size_t>(p, end);
+      else if (d_version < 4.)
+        id = size_t(readBinary<int>(p, end));
+      else
+        id = readBinary<size_t>(p, end);
+
+      auto n = nodeIndex(id, num_data);
+      for (int j = 0; j < num_comp; j++)
+        (*data)[n * num_comp + j] = readValue<double>(p, end, d_binary);
+    }
 
-        // we read through the data irrespective of we found it or not
-        for (size_t i = 0; i < num_data; i++) {
-          double d[field_type];
-          for (size_t j = 0; j < field_type; j++) d_file >> d[j];
+    return true;
+  }
+}
 
-          if (found_data) (*data)[i] = d[0];
-        }
-        // read the end of data block
-        std::getline(d_file, line);
-      }  // end of reading nodes
-    }    // if d_file
+bool rw::reader::MshReader::readPointData(const std::string &name,
+                                          std::vector<util::Point3> *data) {
+  std::vector<double> d;
+  if (!readNodeData(name, 3, &d)) return false;
 
-    if (found_data) break;
+  data->resize(d.size() / 3);
+  for (size_t i = 0; i < data->size(); i++)
+    (*data)[i] = util::Point3(d[3 * i], d[3 * i + 1], d[3 * i + 2]);
 
-    // If !d_file, check to see if EOF was set.  If so, break out
-    // of while loop.
-    if (d_file.eof()) break;
-  }  // while true
+  return true;
+}
 
-  d_file.close();
-  return found_data;
+bool rw::reader::MshReader::readPointData(const std::string &name,
+                                          std::vector<double> *data) {
+  return readNodeData(name, 1, data);
 }
 
-void rw::reader::MshReader::close() {}
+void rw::reader::MshReader::close() {
+  d_buffer.clear();
+  d_buffer.shrink_to_fit();
+}
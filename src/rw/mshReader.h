@@ -10,7 +10,6 @@
 #define RW_MSHREADER_H
 
 #include "util/point.h" // definition of Point3
-#include <fstream>
 #include <string>
 #include <vector>
 
@@ -21,7 +20,13 @@ namespace reader {
 /*!
  * @brief A class to read Gmsh (msh) mesh files
  *
- * This class can only handle Gmsh version 2.0, 2.1, 2.2.
+ * This class can handle Gmsh version 2.0, 2.1, 2.2 and 4.1 in both ascii and
+ * binary format. The file is read into memory once and all subsequent reads
+ * (nodes, elements, point data) work on the memory buffer. Sections which are
+ * not needed for a given read are skipped without parsing them.
+ *
+ * Node tags are expected to be numbered continuously from 1 to the number of
+ * nodes.
  */
 class MshReader {
 
@@ -52,12 +57,14 @@ public:
   /*!
    * @brief Reads nodal position
    *
+   * Only the $Nodes section is parsed.
+   *
    * @param nodes Vector of nodal coordinates
    */
   void readNodes(std::vector<util::Point3> *nodes);
 
   /*!
-   * @brief reads point data from .vtu file
+   * @brief reads point data from .msh file
    * @param name Name of data
    * @param data Pointer to the vector of data
    * @return status True if data is found otherwise false
@@ -65,7 +72,7 @@ public:
   bool readPointData(const std::string &name, std::vector<util::Point3> *data);
 
   /*!
-   * @brief reads point data from .vtu file
+   * @brief reads point data from .msh file
    * @param name Name of data
    * @param data Pointer to the vector of data
    * @return status True if data is found otherwise false
@@ -76,11 +83,57 @@ public:
   void close();
 
 private:
+  /*! @brief Reads the file into memory and parses the $MeshFormat section */
+  void open();
+
+  /*!
+   * @brief Parses the $Nodes section
+   * @param p Cursor positioned after the $Nodes line
+   * @param nodes Vector of nodal coordinates
+   */
+  void readNodesSection(const char *&p, std::vector<util::Point3> *nodes);
+
+  /*!
+   * @brief Parses the $Elements section
+   * @param p Cursor positioned after the $Elements line
+   * @param dim Dimension
+   * @param element_type Type of element
+   * @param num_elem Number of elements
+   * @param enc Vector holding element-node connectivity
+   * @param nec Vector holding node-element connectivity
+   */
+  void readElementsSection(const char *&p, size_t dim, size_t &element_type,
+                           size_t &num_elem, std::vector<size_t> *enc,
+                           std::vector<std::vector<size_t>> *nec);
+
+  /*!
+   * @brief Searches $NodeData sections for data with given name and reads it
+   *
+   * Data is stored component wise, i.e. component j of node i is at location
+   * i * num_comp + j.
+   *
+   * @param name Name of data
+   * @param num_comp Number of components expected for the data
+   * @param data Pointer to the vector of data
+   * @return status True if data is found otherwise false
+   */
+  bool readNodeData(const std::string &name, int num_comp,
+                    std::vector<double> *data);
+
   /*! @brief filename */
   std::string d_filename;
 
-  /*! @brief vtk/vtu file */
-  std::ifstream d_file;
+  /*! @brief Content of msh file */
+  std::string d_buffer;
+
+  /*! @brief Offset in buffer of the first section after $MeshFormat */
+  size_t d_dataStart;
+
+  /*! @brief Version of msh file */
+  double d_version;
+
+  /*! @brief Flag indicating if the file is in binary format */
+  bool d_binary;
 };
 
 } // namespace reader
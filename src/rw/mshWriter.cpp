@@ -4,81 +4,171 @@
 // (See accompanying file LICENSE.txt)
 
 #include "mshWriter.h"
+#include <charconv>
 #include <iostream>
 #include <util/feElementDefs.h>
+#include <zlib.h>
 
-static int ntag = 0;
-static int etag = 0;
+/*! @brief Size of buffer after which the buffer is written to the file */
+static const size_t msh_buffer_size = 1 << 23;
 
 // extern std::ofstream msh_out;
 
 rw::writer::MshWriter::MshWriter(const std::string &filename,
                                  const std::string &compress_type)
-    : d_filename(filename), d_compressType(compress_type), d_file(nullptr) {}
+    : d_filename(filename), d_compressType(compress_type),
+      d_binary(compress_type == "binary" || compress_type == "zlib"),
+      d_nodeTag(0), d_elemTag(0), d_file(nullptr), d_gzFile(nullptr) {
+
+  // unknown compression type, fall back to uncompressed ascii output
+  if (!compress_type.empty() && !d_binary) {
+    std::cout << "Warning: Compression type = " << compress_type
+              << " is not supported for .msh output. Supported types are "
+                 "binary and zlib. Writing uncompressed ascii file.\n";
+    d_compressType = "";
+  }
+}
+
+void rw::writer::MshWriter::write(const char *data, size_t size) {
+  d_buffer.append(data, size);
+  if (d_buffer.size() >= msh_buffer_size) flush();
+}
+
+void rw::writer::MshWriter::flush() {
+  if (d_buffer.empty()) return;
+
+  if (d_gzFile)
+    gzwrite(d_gzFile, d_buffer.data(), (unsigned int)d_buffer.size());
+  else
+    fwrite(d_buffer.data(), 1, d_buffer.size(), d_file);
+  d_buffer.clear();
+}
+
+void rw::writer::MshWriter::writeRecord(size_t id, const double *values,
+                                        size_t num_values) {
+  if (d_binary) {
+    int i = int(id);
+    write(reinterpret_cast<const char *>(&i), sizeof(int));
+    write(reinterpret_cast<const char *>(values), sizeof(double) * num_values);
+    return;
+  }
+
+  // this is same as printing values with "%zu %lf ... %lf\n"
+  char buf[512];
+  auto res = std::to_chars(buf, buf + sizeof(buf), id);
+  d_buffer.append(buf, res.ptr);
+  for (size_t i = 0; i < num_values; i++) {
+    d_buffer.push_back(' ');
+    res = std::to_chars(buf, buf + sizeof(buf), values[i],
+                        std::chars_format::fixed, 6);
+    d_buffer.append(buf, res.ptr);
+  }
+  write("\n", 1);
+}
+
+void rw::writer::MshWriter::writeMshEndTag(const std::string &name) {
+  // in binary format the data is followed by a new line
+  auto tag = (d_binary ? "\n$End" : "$End") + name + "\n";
+  write(tag.data(), tag.size());
+}
 
 void rw::writer::MshWriter::writeMshDataHeader(const std::string &name,
                                                int field_type, size_t num_data,
                                                bool is_node_data) {
+  std::string header;
+
   // Write metadata
   if (is_node_data)
-    fprintf(d_file, "$NodeData\n");
+    header += "$NodeData\n";
   else
-    fprintf(d_file, "$ElementData\n");
+    header += "$ElementData\n";
 
   // number of string the data name has (int)
-  fprintf(d_file, "1\n");
+  header += "1\n";
 
   // name of data (string)
-  fprintf(d_file, "\"%s\"\n", name.c_str());
+  header += "\"" + name + "\"\n";
 
   // default (number of real number tags) (int and double)
-  fprintf(d_file, "1 \n");
-  fprintf(d_file, "1.0 \n");
+  header += "1 \n";
+  header += "1.0 \n";
 
   // three tags in integer (ints)
-  fprintf(d_file, "3 \n");
+  header += "3 \n";
   if (is_node_data) {
-    fprintf(d_file, "%d\n", ntag);
-    ntag++;
+    header += std::to_string(d_nodeTag) + "\n";
+    d_nodeTag++;
   } else {
-    fprintf(d_file, "%d\n", etag);
-    etag++;
+    header += std::to_string(d_elemTag) + "\n";
+    d_elemTag++;
+  }
+  header += std::to_string(field_type) + "\n";
+  header += std::to_string(num_data) + "\n";
+
+  write(header.data(), header.size());
+}
+
+template <class T>
+void rw::writer::MshWriter::writeScalarData(const std::string &name,
+                                            const std::vector<T> *data,
+                                            bool is_node_data) {
+  // Write metadata
+  writeMshDataHeader(name, 1, data->size(), is_node_data);
+  for (size_t i = 0; i < data->size(); i++) {
+    double d = (*data)[i];
+    writeRecord(i + 1, &d, 1);
   }
-  fprintf(d_file, "%d\n", field_type);
-  fprintf(d_file, "%d\n", int(num_data));
+  writeMshEndTag(is_node_data ? "NodeData" : "ElementData");
 }
 
 void rw::writer::MshWriter::appendNodes(const std::vector<util::Point3> *nodes,
                                         const std::vector<util::Point3> *u) {
   // open file stream
-  if (!d_file) {
+  if (!d_file && !d_gzFile) {
     std::string fname = d_filename + ".msh";
-    d_file = fopen(fname.c_str(), "w");
-  }
-  if (!d_file) {
-    std::cerr << "Error: Can not open file = " << d_filename + ".msh"
-              << ".\n";
-    exit(1);
+    if (d_compressType == "zlib") {
+      fname += ".gz";
+      d_gzFile = gzopen(fname.c_str(), "wb");
+    } else
+      d_file = fopen(fname.c_str(), d_binary ? "wb" : "w");
+
+    if (!d_file && !d_gzFile) {
+      std::cerr << "Error: Can not open file = " << fname << ".\n";
+      exit(1);
+    }
+    d_buffer.reserve(msh_buffer_size);
   }
 
   // Write the file header.
-  fprintf(d_file, "$MeshFormat\n");
-  fprintf(d_file, "2.0 0 %zu\n", sizeof(double));
-  fprintf(d_file, "$EndMeshFormat\n");
+  if (d_binary) {
+    std::string header = "$MeshFormat\n2.2 1 " +
+                         std::to_string(sizeof(double)) + "\n";
+    write(header.data(), header.size());
+
+    // integer 1 is written in binary to detect endianness
+    int one = 1;
+    write(reinterpret_cast<const char *>(&one), sizeof(int));
+  } else {
+    std::string header =
+        "$MeshFormat\n2.0 0 " + std::to_string(sizeof(double)) + "\n";
+    write(header.data(), header.size());
+  }
+  writeMshEndTag("MeshFormat");
 
   // get mesh information
   size_t num_nodes = nodes->size();
 
   // write the nodes in (n x y z) format
-  fprintf(d_file, "$Nodes\n");
-  fprintf(d_file, "%zu\n", num_nodes);
+  std::string header = "$Nodes\n" + std::to_string(num_nodes) + "\n";
+  write(header.data(), header.size());
 
   for (size_t i = 0; i < num_nodes; i++) {
     auto p = (*nodes)[i];
     if (u) p = p + (*u)[i];
-    fprintf(d_file, "%zu %lf %lf %lf\n", i + 1, p.d_x, p.d_y, p.d_z);
+    double x[3] = {p.d_x, p.d_y, p.d_z};
+    writeRecord(i + 1, x, 3);
   }
-  fprintf(d_file, "$EndNodes\n");
+  writeMshEndTag("Nodes");
 }
 
 void rw::writer::MshWriter::appendMesh(const std::vector<util::Point3> *nodes,
@@ -93,76 +183,75 @@ void rw::writer::MshWriter::appendMesh(const std::vector<util::Point3> *nodes,
   size_t msh_element_type = util::vtk_to_msh_element_type_map[element_type];
 
   // write the connectivity
-  fprintf(d_file, "$Elements\n");
-  fprintf(d_file, "%zu\n", num_elems);
-
-  // loop over the elements
-  for (size_t e = 0; e < num_elems; e++) {
-    // elements ids are 1 based in Gmsh
-    fprintf(d_file, "%zu %zu 2 0 6 ", e + 1, msh_element_type);
-
-    // write ids of node (numbering starts with 1)
-    for (size_t v = 0; v < num_vertex; v++)
-      fprintf(d_file, "%zu ", (*en_con)[e * num_vertex + v] + 1);
-
-    fprintf(d_file, "\n");
-  }  // element loop
-  fprintf(d_file, "$EndElements\n");
+  std::string header = "$Elements\n" + std::to_string(num_elems) + "\n";
+  write(header.data(), header.size());
+
+  if (d_binary) {
+    // all elements are of same type so we write them in one block with
+    // header (elm-type, num-elm-follow, num-tags)
+    int block[3] = {int(msh_element_type), int(num_elems), 2};
+    write(reinterpret_cast<const char *>(block), sizeof(block));
+
+    std::vector<int> el(3 + num_vertex);
+    for (size_t e = 0; e < num_elems; e++) {
+      el[0] = int(e + 1);
+      el[1] = 0;
+      el[2] = 6;
+      for (size_t v = 0; v < num_vertex; v++)
+        el[3 + v] = int((*en_con)[e * num_vertex + v] + 1);
+      write(reinterpret_cast<const char *>(el.data()),
+            sizeof(int) * el.size());
+    }
+  } else {
+    char buf[32];
+
+    // loop over the elements
+    for (size_t e = 0; e < num_elems; e++) {
+      // elements ids are 1 based in Gmsh
+      auto res = std::to_chars(buf, buf + sizeof(buf), e + 1);
+      d_buffer.append(buf, res.ptr);
+      d_buffer.push_back(' ');
+      res = std::to_chars(buf, buf + sizeof(buf), msh_element_type);
+      d_buffer.append(buf, res.ptr);
+      d_buffer.append(" 2 0 6 ");
+
+      // write ids of node (numbering starts with 1)
+      for (size_t v = 0; v < num_vertex; v++) {
+        res = std::to_chars(buf, buf + sizeof(buf),
+                            (*en_con)[e * num_vertex + v] + 1);
+        d_buffer.append(buf, res.ptr);
+        d_buffer.push_back(' ');
+      }
+
+      write("\n", 1);
+    }  // element loop
+  }
+  writeMshEndTag("Elements");
 }
 
 void rw::writer::MshWriter::appendPointData(const std::string &name,
                                             const std::vector<uint8_t> *data) {
-  // Write metadata
-  writeMshDataHeader(name, 1, data->size(), true);
-  for (size_t i = 0; i < data->size(); i++) {
-    double d = (*data)[i];
-    fprintf(d_file, "%zu %lf\n", i + 1, d);
-  }
-  fprintf(d_file, "$EndNodeData\n");
+  writeScalarData(name, data);
 }
 
 void rw::writer::MshWriter::appendPointData(const std::string &name,
                                             const std::vector<size_t> *data) {
-  // Write metadata
-  writeMshDataHeader(name, 1, data->size(), true);
-  for (size_t i = 0; i < data->size(); i++) {
-    double d = (*data)[i];
-    fprintf(d_file, "%zu %lf\n", i + 1, d);
-  }
-  fprintf(d_file, "$EndNodeData\n");
+  writeScalarData(name, data);
 }
 
 void rw::writer::MshWriter::appendPointData(const std::string &name,
                                             const std::vector<int> *data) {
-  // Write metadata
-  writeMshDataHeader(name, 1, data->size(), true);
-  for (size_t i = 0; i < data->size(); i++) {
-    double d = (*data)[i];
-    fprintf(d_file, "%zu %lf\n", i + 1, d);
-  }
-  fprintf(d_file, "$EndNodeData\n");
+  writeScalarData(name, data);
 }
 
 void rw::writer::MshWriter::appendPointData(const std::string &name,
                                             const std::vector<float> *data) {
-  // Write metadata
-  writeMshDataHeader(name, 1, data->size(), true);
-  for (size_t i = 0; i < data->size(); i++) {
-    double d = (*data)[i];
-    fprintf(d_file, "%zu %lf\n", i + 1, d);
-  }
-  fprintf(d_file, "$EndNodeData\n");
+  writeScalarData(name, data);
 }
 
 void rw::writer::MshWriter::appendPointData(const std::string &name,
                                             const std::vector<double> *data) {
-  // Write metadata
-  writeMshDataHeader(name, 1, data->size(), true);
-  for (size_t i = 0; i < data->size(); i++) {
-    double d = (*data)[i];
-    fprintf(d_file, "%zu %lf\n", i + 1, d);
-  }
-  fprintf(d_file, "$EndNodeData\n");
+  writeScalarData(name, data);
 }
 
 void rw::writer::MshWriter::appendPointData(
@@ -171,9 +260,10 @@ void rw::writer::MshWriter::appendPointData(
   writeMshDataHeader(name, 3, data->size(), true);
   for (size_t i = 0; i < data->size(); i++) {
     auto d = (*data)[i];
-    fprintf(d_file, "%zu %lf %lf %lf\n", i + 1, d.d_x, d.d_y, d.d_z);
+    double x[3] = {d.d_x, d.d_y, d.d_z};
+    writeRecord(i + 1, x, 3);
   }
-  fprintf(d_file, "$EndNodeData\n");
+  writeMshEndTag("NodeData");
 }
 
 void rw::writer::MshWriter::appendPointData(
@@ -182,21 +272,15 @@ void rw::writer::MshWriter::appendPointData(
   writeMshDataHeader(name, 6, data->size(), true);
   for (size_t i = 0; i < data->size(); i++) {
     auto d = (*data)[i];
-    fprintf(d_file, "%zu %lf %lf %lf %lf %lf %lf\n", i + 1, d(0, 0), d(1, 1),
-            d(2, 2), d(1, 2), d(0, 2), d(0, 1));
+    double x[6] = {d(0, 0), d(1, 1), d(2, 2), d(1, 2), d(0, 2), d(0, 1)};
+    writeRecord(i + 1, x, 6);
   }
-  fprintf(d_file, "$EndNodeData\n");
+  writeMshEndTag("NodeData");
 }
 
 void rw::writer::MshWriter::appendCellData(const std::string &name,
                                            const std::vector<float> *data) {
-  // Write metadata
-  writeMshDataHeader(name, 1, data->size(), false);
-  for (size_t i = 0; i < data->size(); i++) {
-    double d = (*data)[i];
-    fprintf(d_file, "%zu %lf\n", i + 1, d);
-  }
-  fprintf(d_file, "$EndElementData\n");
+  writeScalarData(name, data, false);
 }
 
 void rw::writer::MshWriter::appendCellData(
@@ -205,10 +289,10 @@ void rw::writer::MshWriter::appendCellData(
   writeMshDataHeader(name, 6, data->size(), false);
   for (size_t i = 0; i < data->size(); i++) {
     auto d = (*data)[i];
-    fprintf(d_file, "%zu %lf %lf %lf %lf %lf %lf\n", i + 1, d(0, 0), d(1, 1),
-            d(2, 2), d(1, 2), d(0, 2), d(0, 1));
+    double x[6] = {d(0, 0), d(1, 1), d(2, 2), d(1, 2), d(0, 2), d(0, 1)};
+    writeRecord(i + 1, x, 6);
   }
-  fprintf(d_file, "$EndElementData\n");
+  writeMshEndTag("ElementData");
 }
 
 void rw::writer::MshWriter::addTimeStep(const double &timestep) {
@@ -216,15 +300,21 @@ void rw::writer::MshWriter::addTimeStep(const double &timestep) {
 
   // Write metadata
   writeMshDataHeader("time", 1, 1, true);
-  fprintf(d_file, "1 %lf\n", timestep);
-  fprintf(d_file, "$EndNodeData\n");
+  writeRecord(1, &timestep, 1);
+  writeMshEndTag("NodeData");
 }
 
 void rw::writer::MshWriter::close() {
-  ntag = 0;
-  etag = 0;
+  d_nodeTag = 0;
+  d_elemTag = 0;
   d_filename.clear();
-  fclose(d_file);
+
+  flush();
+  d_buffer.shrink_to_fit();
+  if (d_gzFile) gzclose(d_gzFile);
+  if (d_file) fclose(d_file);
+  d_gzFile = nullptr;
+  d_file = nullptr;
 }
 
 void rw::writer::MshWriter::appendFieldData(const std::string &name,
@@ -233,8 +323,8 @@ void rw::writer::MshWriter::appendFieldData(const std::string &name,
 
   // Write metadata
   writeMshDataHeader(name, 1, 1, true);
-  fprintf(d_file, "1 %lf\n", data);
-  fprintf(d_file, "$EndNodeData\n");
+  writeRecord(1, &data, 1);
+  writeMshEndTag("NodeData");
 }
 
 void rw::writer::MshWriter::appendFieldData(const std::string &name,
@@ -243,6 +333,7 @@ void rw::writer::MshWriter::appendFieldData(const std::string &name,
 
   // Write metadata
   writeMshDataHeader(name, 1, 1, true);
-  fprintf(d_file, "1 %lf\n", data);
-  fprintf(d_file, "$EndNodeData\n");
-}
\ No newline at end of file
+  double d = data;
+  writeRecord(1, &d, 1);
+  writeMshEndTag("NodeData");
+}
@@ -9,15 +9,28 @@
 #include "util/matrix.h" // definition of SymMatrix3
 #include "util/point.h"  // definition of Point3
 #include <fstream>
+#include <string>
 #include <vector>
 
+// forward declaration of zlib file handle
+struct gzFile_s;
+
 namespace rw {
 
 namespace writer {
 
 /*! @brief A .msh writer for simple point data and complex fem mesh data
  *
- * We are using Gmsh 2.0 format.
+ * We are using Gmsh 2.0 format for ascii output and Gmsh 2.2 format for
+ * binary output. The output mode is decided by the compression type:
+ * - "" - ascii .msh file
+ * - "binary" - binary .msh file
+ * - "zlib" - binary .msh file compressed with zlib (gzip) to .msh.gz file
+ *
+ * Any other compression type gives a warning and ascii .msh file.
+ *
+ * Data is collected in a large memory buffer which is written to the file
+ * when it is full.
  */
 class MshWriter {
 
@@ -194,14 +207,67 @@ private:
   void writeMshDataHeader(const std::string &name, int field_type,
                           size_t num_data, bool is_node_data = true);
 
+  /*!
+   * @brief Writes the end tag of section
+   * @param name Name of section
+   */
+  void writeMshEndTag(const std::string &name);
+
+  /*!
+   * @brief Writes one record consisting of 1-based id and values
+   *
+   * In ascii format the record is written as a line and in binary format the
+   * id is written as int followed by values written as doubles.
+   *
+   * @param id Id of node or element
+   * @param values Pointer to values
+   * @param num_values Number of values
+   */
+  void writeRecord(size_t id, const double *values, size_t num_values);
+
+  /*!
+   * @brief Writes scalar data
+   * @param name Name of the data
+   * @param data Vector containing the data
+   * @param is_node_data True if data is associated to nodes
+   */
+  template <class T>
+  void writeScalarData(const std::string &name, const std::vector<T> *data,
+                       bool is_node_data = true);
+
+  /*!
+   * @brief Appends the bytes to the buffer and flushes the buffer if it is full
+   * @param data Pointer to the bytes
+   * @param size Number of bytes
+   */
+  void write(const char *data, size_t size);
+
+  /*! @brief Writes the buffer to the file */
+  void flush();
+
   /*! @brief filename */
   std::string d_filename;
 
   /*! @brief compression_type Specify the compressor (if any) */
   std::string d_compressType;
 
-  /*! @brief vtk/vtu file */
+  /*! @brief Flag indicating if the file is written in binary format */
+  bool d_binary;
+
+  /*! @brief Buffer holding data which is not yet written to the file */
+  std::string d_buffer;
+
+  /*! @brief Tag of next node data block */
+  int d_nodeTag;
+
+  /*! @brief Tag of next element data block */
+  int d_elemTag;
+
+  /*! @brief msh file */
   FILE *d_file;
+
+  /*! @brief Compressed msh file */
+  gzFile_s *d_gzFile;
 };
 
 } // namespace writer
@@ -7,51 +7,17 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "reader.h"
-#include "csv.h"
+#include "csvReader.h"
 #include "mshReader.h"
 #include "vtkReader.h"
 
 void rw::reader::readCsvFile(const std::string &filename, size_t dim,
                              std::vector<util::Point3> *nodes,
-                             std::vector<double> *volumes) {
-  nodes->clear();
-  volumes->clear();
-  if (dim == 1) {
-    io::CSVReader<3> in(filename);
-    in.read_header(io::ignore_extra_column, "id", "x", "volume");
-
-    double x;
-    double volume;
-    int id;
-    while (in.read_row(id, x, volume)) {
-      volumes->emplace_back(volume);
-      nodes->emplace_back(util::Point3(x, 0., 0.));
-    }
-  }
-
-  if (dim == 2) {
-    io::CSVReader<4> in(filename);
-    in.read_header(io::ignore_extra_column, "id", "x", "y", "volume");
-
-    double x, y, volume;
-    int id;
-    while (in.read_row(id, x, y, volume)) {
-      volumes->emplace_back(volume);
-      nodes->emplace_back(util::Point3(x, y, 0.));
-    }
-  }
-
-  if (dim == 3) {
-    io::CSVReader<5> in(filename);
-    in.read_header(io::ignore_extra_column, "id", "x", "y", "z", "volume");
-
-    double x, y, z, volume;
-    int id;
-    while (in.read_row(id, x, y, z, volume)) {
-      volumes->emplace_back(volume);
-      nodes->emplace_back(util::Point3(x, y, z));
-    }
-  }
+                             std::vector<double> *volumes,
+                             std::vector<uint8_t> *fixity) {
+  auto rdr = rw::reader::CsvReader(filename);
+  rdr.readNodes(dim, nodes, volumes, fixity);
+  rdr.close();
 }
 
 void rw::reader::readVtuFile(const std::string &filename, size_t dim,
@@ -145,6 +111,15 @@ void rw::reader::readVtuFileCells(const std::string &filename, size_t dim,
   rdr.close();
 }
 
+void rw::reader::scaleVtuFileDisplacement(const std::string &filename,
+                                          const std::string &out_filename,
+                                          const double &scale_factor,
+                                          const std::string &compress_type) {
+  auto rdr = rw::reader::VtkReader(filename);
+  rdr.writeScaledDisplacement(out_filename, scale_factor, compress_type);
+  rdr.close();
+}
+
 void rw::reader::readVtuFileRestart(const std::string &filename,
                                     std::vector<util::Point3> *u,
                                     std::vector<util::Point3> *v,
@@ -355,9 +330,9 @@ void rw::reader::readMshFileRestart(const std::string &filename,
 bool rw::reader::readMshFilePointData(const std::string &filename,
                                       const std::string &tag,
                                       std::vector<double> *data) {
-  // call vtk reader
-  auto rdr = rw::reader::VtkReader(filename);
-  // get velocity
+  // call msh reader
+  auto rdr = rw::reader::MshReader(filename);
+  // read data
   auto st = rdr.readPointData(tag, data);
   rdr.close();
   return st;
@@ -42,10 +42,13 @@ namespace reader {
  * @param dim Dimension
  * @param nodes Vector of nodes data
  * @param volumes Vector holding volume of the nodes
+ * @param fixity Vector holding fixity mask of the nodes (read only if file
+ * has fixity column)
  */
 void readCsvFile(const std::string &filename, size_t dim,
                  std::vector<util::Point3> *nodes,
-                 std::vector<double> *volumes);
+                 std::vector<double> *volumes,
+                 std::vector<uint8_t> *fixity = nullptr);
 
 /** @}*/
 
@@ -154,6 +157,21 @@ bool readVtuFilePointData(const std::string &filename,
                           const std::string &tag,
                           std::vector<uint8_t> *data);
 
+/*!
+ * @brief Writes copy of vtu file with displacement scaled
+ *
+ * See rw::reader::VtkReader::writeScaledDisplacement().
+ *
+ * @param filename Name of mesh file
+ * @param out_filename Name of output file (without extension)
+ * @param scale_factor Scale factor for displacement
+ * @param compress_type Compression method (optional)
+ */
+void scaleVtuFileDisplacement(const std::string &filename,
+                              const std::string &out_filename,
+                              const double &scale_factor,
+                              const std::string &compress_type = "");
+
 /*!
  * @brief Reads data of specified tag from the vtu file
  * @param filename Name of mesh file
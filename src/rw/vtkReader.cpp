@@ -8,6 +8,7 @@
 
 #include "vtkReader.h"
 
+#include <iostream>
 #include <vtkAbstractArray.h>
 #include <vtkCellArray.h>
 #include <vtkCellData.h>
@@ -19,10 +20,11 @@
 #include <vtkPoints.h>
 #include <vtkUnsignedCharArray.h>
 #include <vtkUnsignedIntArray.h>
+#include <vtkXMLUnstructuredGridWriter.h>
 
 #include "util/feElementDefs.h"
 
-size_t rw::reader::VtkReader::d_count = 0;
+std::atomic<size_t> rw::reader::VtkReader::d_count(0);
 
 rw::reader::VtkReader::VtkReader(const std::string &filename) {
   d_count++;
@@ -663,6 +665,50 @@ bool rw::reader::VtkReader::readCellData(const std::string &name,
   return true;
 }
 
+void rw::reader::VtkReader::writeScaledDisplacement(
+    const std::string &filename, const double &scale_factor,
+    const std::string &compress_type) {
+  d_grid_p = d_reader_p->GetOutput();
+  auto u = d_grid_p->GetPointData()->GetArray("Displacement");
+  if (u == nullptr) {
+    std::cerr << "Error: Did not find displacement in the vtu file.\n";
+    exit(1);
+  }
+
+  // new positions of nodes
+  vtkIdType num_nodes = d_grid_p->GetNumberOfPoints();
+  auto points = vtkSmartPointer<vtkPoints>::New();
+  points->SetDataType(d_grid_p->GetPoints()->GetDataType());
+  points->SetNumberOfPoints(num_nodes);
+  for (vtkIdType i = 0; i < num_nodes; i++) {
+    double x[3], ui[3];
+    d_grid_p->GetPoint(i, x);
+    u->GetTuple(i, ui);
+    for (size_t dof = 0; dof < 3; dof++)
+      x[dof] += (scale_factor - 1.) * ui[dof];
+    points->SetPoint(i, x);
+  }
+
+  // share remaining data with input grid
+  auto grid = vtkSmartPointer<vtkUnstructuredGrid>::New();
+  grid->ShallowCopy(d_grid_p);
+  grid->SetPoints(points);
+
+  std::string f = filename + ".vtu";
+  auto writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+  writer->SetFileName(const_cast<char *>(f.c_str()));
+  writer->SetInputData(grid);
+  writer->SetDataModeToAppended();
+  if (compress_type == "zlib") {
+    writer->EncodeAppendedDataOn();
+    writer->SetCompressorTypeToZLib();
+  } else {
+    writer->EncodeAppendedDataOff();
+    writer->SetCompressor(0);
+  }
+  writer->Write();
+}
+
 void rw::reader::VtkReader::close() {
   // delete d_reader_p;
   // delete d_grid_p;
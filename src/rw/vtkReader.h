@@ -9,6 +9,7 @@
 #ifndef RW_VTKREADER_H
 #define RW_VTKREADER_H
 
+#include <atomic>
 #include <util/matrixBlaze.h>
 #include <vtkSmartPointer.h>
 #include <vtkUnstructuredGrid.h>
@@ -208,12 +209,30 @@ public:
    */
   bool readCellData(const std::string &name, std::vector<util::Matrix33> *data);
 
+  /*!
+   * @brief Writes the data of file to new .vtu file with displacement scaled
+   *
+   * Nodes in new file are at \f$ X + s u \f$, where \f$ X + u \f$ is the
+   * position of node in this file, \f$ u \f$ is the displacement and \f$ s
+   * \f$ is the scale factor. Cells, point data, cell data and field data
+   * (e.g. time) are shared with the data read from this file and written as
+   * they are. Without compression, data arrays are written as raw binary
+   * so that arrays are copied and not encoded.
+   *
+   * @param filename Name of output file (without extension)
+   * @param scale_factor Scale factor for displacement
+   * @param compress_type Compression method (optional)
+   */
+  void writeScaledDisplacement(const std::string &filename,
+                               const double &scale_factor,
+                               const std::string &compress_type = "");
+
   /*! @brief Close the file */
   void close();
 
 private:
   /*! @brief Counter */
-  static size_t d_count;
+  static std::atomic<size_t> d_count;
 
   /*! @brief XML unstructured grid writer */
   vtkSmartPointer<vtkXMLUnstructuredGridReader> d_reader_p;
@@ -7,19 +7,27 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include "vtkWriter.h"
+#include <hpx/include/parallel_algorithm.hpp>
+#include <iostream>
+#include <unordered_map>
 #include <util/feElementDefs.h>
 #include <vtkCellArray.h>
 #include <vtkCellData.h>
+#include <vtkDataSetAttributes.h>
 #include <vtkDoubleArray.h>
+#include <vtkFieldData.h>
 #include <vtkIdList.h>
 #include <vtkIntArray.h>
 #include <vtkPointData.h>
 #include <vtkPoints.h>
+#include <vtkUnsignedCharArray.h>
 #include <vtkUnsignedIntArray.h>
 
 rw::writer::VtkWriter::VtkWriter(const std::string &filename,
-                                 const std::string &compress_type)
-    : d_compressType(compress_type) {
+                                 const std::string &compress_type,
+                                 size_t num_pieces)
+    : d_filename(filename), d_numPieces(num_pieces),
+      d_compressType(compress_type) {
   std::string f = filename + ".vtu";
 
   d_writer_p = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
@@ -286,6 +294,11 @@ void rw::writer::VtkWriter::addTimeStep(const double &timestep) {
 }
 
 void rw::writer::VtkWriter::close() {
+  if (d_numPieces > 1) {
+    writePieces();
+    return;
+  }
+
   d_writer_p->SetInputData(d_grid_p);
   d_writer_p->SetDataModeToAppended();
   d_writer_p->EncodeAppendedDataOn();
@@ -313,3 +326,226 @@ void rw::writer::VtkWriter::appendFieldData(const std::string &name,
   t->SetTuple1(0, data);
   d_grid_p->GetFieldData()->AddArray(t);
 }
+
+namespace {
+
+/*! @brief Returns the name of vtk data type used in xml files */
+std::string getXMLDataType(int data_type) {
+  if (data_type == VTK_FLOAT) return "Float32";
+  if (data_type == VTK_UNSIGNED_CHAR) return "UInt8";
+  return "Float64";
+}
+
+/*! @brief Copies the tuples of source array at given ids to new array */
+vtkSmartPointer<vtkDoubleArray> copyTuples(vtkDataArray *src,
+                                           const std::vector<vtkIdType> &ids) {
+  auto array = vtkSmartPointer<vtkDoubleArray>::New();
+  array->SetNumberOfComponents(src->GetNumberOfComponents());
+  array->SetName(src->GetName());
+  for (int j = 0; j < src->GetNumberOfComponents(); j++)
+    if (src->GetComponentName(j))
+      array->SetComponentName(j, src->GetComponentName(j));
+
+  array->SetNumberOfTuples(ids.size());
+  std::vector<double> value(src->GetNumberOfComponents());
+  for (size_t i = 0; i < ids.size(); i++) {
+    src->GetTuple(ids[i], value.data());
+    array->SetTuple(i, value.data());
+  }
+
+  return array;
+}
+
+} // namespace
+
+void rw::writer::VtkWriter::writePieces() {
+  auto num_nodes = size_t(d_grid_p->GetNumberOfPoints());
+  auto num_cells = size_t(d_grid_p->GetNumberOfCells());
+  size_t num_pieces = std::min(d_numPieces, std::max(num_nodes, size_t(1)));
+
+  // nodes [piece_start[k], piece_start[k+1]) are owned by piece k
+  std::vector<size_t> piece_start(num_pieces + 1);
+  for (size_t k = 0; k <= num_pieces; k++)
+    piece_start[k] = k * num_nodes / num_pieces;
+  auto get_piece = [&piece_start, num_nodes, num_pieces](size_t i) {
+    size_t k = i * num_pieces / num_nodes;
+    while (piece_start[k + 1] <= i) k++;
+    while (piece_start[k] > i) k--;
+    return k;
+  };
+
+  // global ids of nodes and cells of each piece and connectivity of cells in
+  // local numbering
+  std::vector<std::vector<vtkIdType>> piece_nodes(num_pieces);
+  std::vector<std::vector<vtkIdType>> piece_cells(num_pieces);
+  std::vector<std::vector<vtkIdType>> piece_con(num_pieces);
+  std::vector<std::vector<int>> piece_cell_types(num_pieces);
+  for (size_t k = 0; k < num_pieces; k++)
+    for (size_t i = piece_start[k]; i < piece_start[k + 1]; i++)
+      piece_nodes[k].push_back(i);
+
+  if (num_cells > 0) {
+    std::vector<std::unordered_map<vtkIdType, vtkIdType>> ghost_ids(
+        num_pieces);
+    auto ids = vtkSmartPointer<vtkIdList>::New();
+    for (size_t e = 0; e < num_cells; e++) {
+      d_grid_p->GetCellPoints(e, ids);
+      if (ids->GetNumberOfIds() == 0) continue;
+
+      auto k = get_piece(ids->GetId(0));
+      piece_cells[k].push_back(e);
+      piece_cell_types[k].push_back(d_grid_p->GetCellType(e));
+      piece_con[k].push_back(ids->GetNumberOfIds());
+      for (vtkIdType v = 0; v < ids->GetNumberOfIds(); v++) {
+        auto n = size_t(ids->GetId(v));
+        if (n >= piece_start[k] && n < piece_start[k + 1])
+          piece_con[k].push_back(n - piece_start[k]);
+        else {
+          // node of other piece is added to this piece
+          auto it = ghost_ids[k].find(n);
+          if (it == ghost_ids[k].end()) {
+            it = ghost_ids[k].emplace(n, piece_nodes[k].size()).first;
+            piece_nodes[k].push_back(n);
+          }
+          piece_con[k].push_back(it->second);
+        }
+      }
+    }
+  }
+
+  // data arrays
+  std::vector<vtkDataArray *> point_arrays;
+  for (int a = 0; a < d_grid_p->GetPointData()->GetNumberOfArrays(); a++)
+    point_arrays.push_back(d_grid_p->GetPointData()->GetArray(a));
+  std::vector<vtkDataArray *> cell_arrays;
+  for (int a = 0; a < d_grid_p->GetCellData()->GetNumberOfArrays(); a++)
+    cell_arrays.push_back(d_grid_p->GetCellData()->GetArray(a));
+
+  // name of piece files relative to .pvtu file
+  auto base = d_filename.substr(d_filename.find_last_of('/') + 1);
+
+  // create grid of pieces (field data is copied here as reference counting
+  // of shared arrays is not safe in parallel)
+  std::vector<vtkSmartPointer<vtkUnstructuredGrid>> grids(num_pieces);
+  for (size_t k = 0; k < num_pieces; k++) {
+    grids[k] = vtkSmartPointer<vtkUnstructuredGrid>::New();
+    grids[k]->GetFieldData()->DeepCopy(d_grid_p->GetFieldData());
+  }
+
+  // write pieces
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      num_pieces,
+      [this, &grids, &piece_start, &piece_nodes, &piece_cells, &piece_con,
+       &piece_cell_types, &point_arrays, &cell_arrays](boost::uint64_t k) {
+        const auto &nodes = piece_nodes[k];
+        auto grid = grids[k];
+
+        auto points = vtkSmartPointer<vtkPoints>::New();
+        points->SetNumberOfPoints(nodes.size());
+        double x[3];
+        for (size_t i = 0; i < nodes.size(); i++) {
+          d_grid_p->GetPoints()->GetPoint(nodes[i], x);
+          points->SetPoint(i, x);
+        }
+        grid->SetPoints(points);
+
+        if (!piece_cells[k].empty()) {
+          auto cells = vtkSmartPointer<vtkCellArray>::New();
+          size_t pos = 0;
+          while (pos < piece_con[k].size()) {
+            auto n = piece_con[k][pos];
+            cells->InsertNextCell(n, &piece_con[k][pos + 1]);
+            pos += n + 1;
+          }
+          grid->SetCells(piece_cell_types[k].data(), cells);
+        }
+
+        for (auto a : point_arrays)
+          grid->GetPointData()->AddArray(copyTuples(a, nodes));
+
+        // mark nodes of other pieces as duplicate so that they are skipped
+        // when pieces are combined (cells are not duplicated)
+        auto ghost = vtkSmartPointer<vtkUnsignedCharArray>::New();
+        ghost->SetName(vtkDataSetAttributes::GhostArrayName());
+        ghost->SetNumberOfTuples(nodes.size());
+        size_t num_owned = piece_start[k + 1] - piece_start[k];
+        for (size_t i = 0; i < nodes.size(); i++)
+          ghost->SetValue(i, i < num_owned
+                                 ? 0
+                                 : vtkDataSetAttributes::DUPLICATEPOINT);
+        grid->GetPointData()->AddArray(ghost);
+        for (auto a : cell_arrays)
+          grid->GetCellData()->AddArray(copyTuples(a, piece_cells[k]));
+
+        auto writer = vtkSmartPointer<vtkXMLUnstructuredGridWriter>::New();
+        std::string piece_filename =
+            d_filename + "_p" + std::to_string(k) + ".vtu";
+        writer->SetFileName(const_cast<char *>(piece_filename.c_str()));
+        writer->SetInputData(grid);
+        writer->SetDataModeToAppended();
+        writer->EncodeAppendedDataOn();
+        if (d_compressType == "zlib")
+          writer->SetCompressorTypeToZLib();
+        else
+          writer->SetCompressor(0);
+        writer->Write();
+      });  // end of parallel for loop
+
+  // write .pvtu file while pieces are being written
+  std::string fname = d_filename + ".pvtu";
+  FILE *fout = fopen(fname.c_str(), "w");
+  if (!fout) {
+    std::cerr << "Error: Can not open file = " << fname << ".\n";
+    exit(1);
+  }
+
+  // pieces are written in byte order of this machine
+  int one = 1;
+  bool little_endian = *reinterpret_cast<char *>(&one) == 1;
+
+  fprintf(fout, "<?xml version=\"1.0\"?>\n");
+  fprintf(fout,
+          "<VTKFile type=\"PUnstructuredGrid\" version=\"0.1\" "
+          "byte_order=\"%s\">\n",
+          little_endian ? "LittleEndian" : "BigEndian");
+  fprintf(fout, "  <PUnstructuredGrid GhostLevel=\"0\">\n");
+
+  fprintf(fout, "    <PPointData>\n");
+  for (auto a : point_arrays)
+    fprintf(fout,
+            "      <PDataArray type=\"%s\" Name=\"%s\" "
+            "NumberOfComponents=\"%d\"/>\n",
+            getXMLDataType(VTK_DOUBLE).c_str(), a->GetName(),
+            a->GetNumberOfComponents());
+  fprintf(fout,
+          "      <PDataArray type=\"%s\" Name=\"%s\" "
+          "NumberOfComponents=\"1\"/>\n",
+          getXMLDataType(VTK_UNSIGNED_CHAR).c_str(),
+          vtkDataSetAttributes::GhostArrayName());
+  fprintf(fout, "    </PPointData>\n");
+
+  fprintf(fout, "    <PCellData>\n");
+  for (auto a : cell_arrays)
+    fprintf(fout,
+            "      <PDataArray type=\"%s\" Name=\"%s\" "
+            "NumberOfComponents=\"%d\"/>\n",
+            getXMLDataType(VTK_DOUBLE).c_str(), a->GetName(),
+            a->GetNumberOfComponents());
+  fprintf(fout, "    </PCellData>\n");
+
+  fprintf(fout, "    <PPoints>\n");
+  fprintf(fout,
+          "      <PDataArray type=\"%s\" NumberOfComponents=\"3\"/>\n",
+          getXMLDataType(d_grid_p->GetPoints()->GetDataType()).c_str());
+  fprintf(fout, "    </PPoints>\n");
+
+  for (size_t k = 0; k < num_pieces; k++)
+    fprintf(fout, "    <Piece Source=\"%s_p%zu.vtu\"/>\n", base.c_str(), k);
+
+  fprintf(fout, "  </PUnstructuredGrid>\n");
+  fprintf(fout, "</VTKFile>\n");
+  fclose(fout);
+
+  f.get();
+}
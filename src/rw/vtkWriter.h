@@ -30,10 +30,17 @@ public:
    * Creates and opens .vtu file of name given by filename. The file remains
    * open till the close() function is invoked.
    *
+   * If number of pieces is more than one, the nodes are split into pieces
+   * which are written in parallel to files filename_p<k>.vtu and the file
+   * filename.pvtu listing the pieces is created.
+   *
    * @param filename Name of file which will be created
    * @param compress_type Compression method (optional)
+   * @param num_pieces Number of pieces (optional)
    */
-  explicit VtkWriter(const std::string &filename, const std::string &compress_type = "");
+  explicit VtkWriter(const std::string &filename,
+                     const std::string &compress_type = "",
+                     size_t num_pieces = 1);
 
   /**
    * @name Mesh data
@@ -190,6 +197,23 @@ public:
   void close();
 
 private:
+  /*!
+   * @brief Splits the grid into pieces and writes the pieces in parallel
+   * together with .pvtu file
+   *
+   * Piece k owns the nodes in k-th contiguous block of nodes and the cells
+   * whose first vertex is owned by it. Nodes of owned cells which belong to
+   * other pieces are duplicated in the piece and marked as duplicate points
+   * in the vtkGhostType point array.
+   */
+  void writePieces();
+
+  /*! @brief filename without extension */
+  std::string d_filename;
+
+  /*! @brief Number of pieces */
+  size_t d_numPieces;
+
   /*! @brief XML unstructured grid writer */
   vtkSmartPointer<vtkXMLUnstructuredGridWriter> d_writer_p;
 
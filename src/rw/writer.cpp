@@ -10,133 +10,264 @@
 #include "vtkWriter.h"
 #include "legacyVtkWriter.h"
 #include "mshWriter.h"
+#ifdef ENABLE_HDF5
+#include "hdf5Writer.h"
+#endif
+#include <iostream>
+
+namespace {
+
+/*!
+ * @brief Returns nodal data in original order of nodes
+ *
+ * @param data Pointer to nodal data in current order
+ * @param ids Original ids of nodes (nullptr if nodes are not reordered)
+ * @param buf Pointer to vector used to store permuted data
+ * @return data Pointer to nodal data in original order
+ */
+template <class T>
+const std::vector<T> *toOriginalOrder(const std::vector<T> *data,
+                                      const std::vector<size_t> *ids,
+                                      std::vector<T> *buf) {
+  if (ids == nullptr || data == nullptr || data->size() != ids->size())
+    return data;
+
+  buf->resize(data->size());
+  for (size_t i = 0; i < data->size(); i++) (*buf)[(*ids)[i]] = (*data)[i];
+
+  return buf;
+}
+
+}  // namespace
 
 rw::writer::Writer::Writer()
     : d_vtkWriter_p(nullptr),
       d_legacyVtkWriter_p(nullptr),
       d_mshWriter_p(nullptr),
-      d_format("vtu") {}
+      d_hdf5Writer_p(nullptr),
+      d_format("vtu"),
+      d_nodeIds_p(nullptr) {}
 
 rw::writer::Writer::Writer(const std::string &filename,
                            const std::string &format,
-                           const std::string &compress_type)
+                           const std::string &compress_type,
+                           size_t num_pieces)
     : d_vtkWriter_p(nullptr),
       d_legacyVtkWriter_p(nullptr),
       d_mshWriter_p(nullptr),
-      d_format("vtu") {
-  open(filename, format, compress_type);
+      d_hdf5Writer_p(nullptr),
+      d_format("vtu"),
+      d_nodeIds_p(nullptr) {
+  open(filename, format, compress_type, num_pieces);
 }
 
 void rw::writer::Writer::open(const std::string &filename,
                               const std::string &format,
-                              const std::string &compress_type) {
+                              const std::string &compress_type,
+                              size_t num_pieces) {
   d_format = format;
   if (d_format == "vtu")
-    d_vtkWriter_p = new rw::writer::VtkWriter(filename, compress_type);
+    d_vtkWriter_p =
+        new rw::writer::VtkWriter(filename, compress_type, num_pieces);
   else if (d_format == "msh")
     d_mshWriter_p = new rw::writer::MshWriter(filename, compress_type);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p =
         new rw::writer::LegacyVtkWriter(filename, compress_type);
+  else if (d_format == "hdf5") {
+#ifdef ENABLE_HDF5
+    d_hdf5Writer_p = new rw::writer::Hdf5Writer(filename, compress_type);
+#else
+    std::cerr << "Error: Output format hdf5 requires NLMech to be built with "
+                 "Enable_HDF5.\n";
+    exit(1);
+#endif
+  }
 }
 
-rw::writer::Writer::~Writer() { delete (d_vtkWriter_p); }
+rw::writer::Writer::~Writer() {
+  delete (d_vtkWriter_p);
+#ifdef ENABLE_HDF5
+  delete (d_hdf5Writer_p);
+#endif
+}
+
+void rw::writer::Writer::setNodeOrder(const std::vector<size_t> *ids) {
+  d_nodeIds_p = (ids && !ids->empty()) ? ids : nullptr;
+}
 
 void rw::writer::Writer::appendNodes(const std::vector<util::Point3> *nodes,
                                      const std::vector<util::Point3> *u) {
+  std::vector<util::Point3> nodes_buf, u_buf;
+  nodes = toOriginalOrder(nodes, d_nodeIds_p, &nodes_buf);
+  u = toOriginalOrder(u, d_nodeIds_p, &u_buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendNodes(nodes, u);
   else if (d_format == "msh")
     d_mshWriter_p->appendNodes(nodes, u);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendNodes(nodes, u);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendNodes(nodes, u);
+#endif
 }
 
 void rw::writer::Writer::appendMesh(const std::vector<util::Point3> *nodes,
                                     const size_t &element_type,
                                     const std::vector<size_t> *en_con,
                                     const std::vector<util::Point3> *u) {
+  std::vector<util::Point3> nodes_buf, u_buf;
+  nodes = toOriginalOrder(nodes, d_nodeIds_p, &nodes_buf);
+  u = toOriginalOrder(u, d_nodeIds_p, &u_buf);
+
+  // element-node connectivity in terms of original ids of nodes
+  std::vector<size_t> en_con_buf;
+  if (d_nodeIds_p && en_con) {
+    en_con_buf.resize(en_con->size());
+    for (size_t i = 0; i < en_con->size(); i++)
+      en_con_buf[i] = (*d_nodeIds_p)[(*en_con)[i]];
+    en_con = &en_con_buf;
+  }
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendMesh(nodes, element_type, en_con, u);
   else if (d_format == "msh")
     d_mshWriter_p->appendMesh(nodes, element_type, en_con, u);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendMesh(nodes, element_type, en_con, u);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendMesh(nodes, element_type, en_con, u);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(const std::string &name,
                                          const std::vector<uint8_t> *data) {
+  std::vector<uint8_t> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendPointData(name, data);
   else if (d_format == "msh")
     d_mshWriter_p->appendPointData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendPointData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendPointData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(const std::string &name,
                                          const std::vector<size_t> *data) {
+  std::vector<size_t> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendPointData(name, data);
   else if (d_format == "msh")
     d_mshWriter_p->appendPointData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendPointData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendPointData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(const std::string &name,
                                          const std::vector<int> *data) {
+  std::vector<int> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendPointData(name, data);
   else if (d_format == "msh")
     d_mshWriter_p->appendPointData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendPointData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendPointData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(const std::string &name,
                                          const std::vector<float> *data) {
+  std::vector<float> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendPointData(name, data);
   else if (d_format == "msh")
     d_mshWriter_p->appendPointData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendPointData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendPointData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(const std::string &name,
                                          const std::vector<double> *data) {
+  std::vector<double> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendPointData(name, data);
   else if (d_format == "msh")
     d_mshWriter_p->appendPointData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendPointData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendPointData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(
     const std::string &name, const std::vector<util::Point3> *data) {
+  std::vector<util::Point3> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendPointData(name, data);
   else if (d_format == "msh")
     d_mshWriter_p->appendPointData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendPointData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendPointData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(
     const std::string &name, const std::vector<util::SymMatrix3> *data) {
+  std::vector<util::SymMatrix3> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu")
     d_vtkWriter_p->appendPointData(name, data);
   else if (d_format == "msh")
     d_mshWriter_p->appendPointData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendPointData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendPointData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendPointData(
     const std::string &name,
     const std::vector<blaze::StaticMatrix<double, 3, 3> > *data) {
+  std::vector<blaze::StaticMatrix<double, 3, 3>> buf;
+  data = toOriginalOrder(data, d_nodeIds_p, &buf);
+
   if (d_format == "vtu") d_vtkWriter_p->appendPointData(name, data);
   // else if (d_format == "msh")
   //  d_mshWriter_p->appendPointData(name, data);
@@ -152,6 +283,10 @@ void rw::writer::Writer::appendCellData(const std::string &name,
     d_mshWriter_p->appendCellData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendCellData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendCellData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendCellData(
@@ -162,6 +297,10 @@ void rw::writer::Writer::appendCellData(
     d_mshWriter_p->appendCellData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendCellData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendCellData(name, data);
+#endif
 }
 
 void rw::writer::Writer::addTimeStep(const double &timestep) {
@@ -171,6 +310,10 @@ void rw::writer::Writer::addTimeStep(const double &timestep) {
     d_mshWriter_p->addTimeStep(timestep);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->addTimeStep(timestep);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->addTimeStep(timestep);
+#endif
 }
 
 void rw::writer::Writer::appendFieldData(const std::string &name,
@@ -181,6 +324,10 @@ void rw::writer::Writer::appendFieldData(const std::string &name,
     d_mshWriter_p->appendFieldData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendFieldData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendFieldData(name, data);
+#endif
 }
 
 void rw::writer::Writer::appendFieldData(const std::string &name,
@@ -191,6 +338,10 @@ void rw::writer::Writer::appendFieldData(const std::string &name,
     d_mshWriter_p->appendFieldData(name, data);
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->appendFieldData(name, data);
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->appendFieldData(name, data);
+#endif
 }
 
 void rw::writer::Writer::close() {
@@ -200,4 +351,8 @@ void rw::writer::Writer::close() {
     d_mshWriter_p->close();
   else if (d_format == "legacy_vtk")
     d_legacyVtkWriter_p->close();
+#ifdef ENABLE_HDF5
+  else if (d_format == "hdf5")
+    d_hdf5Writer_p->close();
+#endif
 }
@@ -20,6 +20,7 @@ namespace writer {
 class VtkWriter;
 class LegacyVtkWriter;
 class MshWriter;
+class Hdf5Writer;
 }
 } // namespace rw
 
@@ -29,7 +30,8 @@ namespace rw {
  * @brief Collection of methods and database related to writing
  *
  * This namespace provides methods and data members specific to writing of
- * the mesh data and simulation data. Currently, .vtu and .msh is supported.
+ * the mesh data and simulation data. Currently, .vtu, .msh and (if built with
+ * Enable_HDF5) .h5/.xmf time series is supported.
  */
 namespace writer {
 
@@ -54,11 +56,12 @@ public:
    * class is destroyed.
    *
    * @param filename Name of file which will be created
-   * @param format Format of the output file, e.g. "vtu", "msh"
+   * @param format Format of the output file, e.g. "vtu", "msh", "hdf5"
    * @param compress_type Specify the compression type (optional)
+   * @param num_pieces Number of pieces written in parallel (only for vtu)
    */
   explicit Writer(const std::string &filename, const std::string &format =
-    "vtu", const std::string &compress_type = "");
+    "vtu", const std::string &compress_type = "", size_t num_pieces = 1);
 
   /*! @brief Destructor */
   ~Writer();
@@ -67,11 +70,24 @@ public:
    * @brief Open a .vtu file
    *
    * @param filename Name of file which will be created
-   * @param format Format of the output file, e.g. "vtu", "msh"
+   * @param format Format of the output file, e.g. "vtu", "msh", "hdf5"
    * @param compress_type Compression type (optional)
+   * @param num_pieces Number of pieces written in parallel (only for vtu)
    */
   void open(const std::string &filename, const std::string &format = "vtu",
-            const std::string &compress_type = "");
+            const std::string &compress_type = "", size_t num_pieces = 1);
+
+  /*!
+   * @brief Sets the original ids of nodes
+   *
+   * If nodes are reordered in simulation, nodal data, nodes and
+   * element-node connectivity are written in the original order of nodes.
+   * Entry i of ids is the original id of node i. Empty list or nullptr means
+   * nodes are not reordered.
+   *
+   * @param ids Pointer to list of original ids of nodes
+   */
+  void setNodeOrder(const std::vector<size_t> *ids);
 
   /**
    * @name Mesh data
@@ -236,9 +252,15 @@ private:
   /*! @brief Pointer to the vtk writer class */
   rw::writer::MshWriter *d_mshWriter_p;
 
+  /*! @brief Pointer to the hdf5 writer class */
+  rw::writer::Hdf5Writer *d_hdf5Writer_p;
+
   /*! @brief Format of output file */
   std::string d_format;
 
+  /*! @brief Original ids of nodes (nullptr if nodes are not reordered) */
+  const std::vector<size_t> *d_nodeIds_p;
+
 }; // class Writer
 
 } // namespace writer
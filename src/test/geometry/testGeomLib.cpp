@@ -31,7 +31,7 @@ static void printBits(const std::string &filename,
   for (size_t i = 0; i < nodes.size(); i++) {
     auto list = fracture->getBonds(i);
     for (auto k : list) {
-      std::bitset<8> a(k);
+      std::bitset<64> a(k);
       myfile << a;
     }
     myfile << "\n";
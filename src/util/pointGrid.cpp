@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "pointGrid.h"
+
+#include <algorithm>
+#include <cmath>
+#include <hpx/include/parallel_algorithm.hpp>
+#include <limits>
+
+util::PointGrid::PointGrid() : d_cellSize(0.), d_numCells{0, 0, 0} {}
+
+util::PointGrid::PointGrid(const std::vector<util::Point3> *points,
+                           const double &cell_size,
+                           const std::vector<util::Point3> *u)
+    : d_cellSize(0.), d_numCells{0, 0, 0} {
+  build(points, cell_size, u);
+}
+
+void util::PointGrid::build(const std::vector<util::Point3> *points,
+                            const double &cell_size,
+                            const std::vector<util::Point3> *u) {
+  size_t n = points->size();
+  d_points.resize(n);
+  d_cellStart.clear();
+  d_cellPoints.clear();
+  if (n == 0) return;
+
+  // copy positions
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0, n,
+      [this, points, u](boost::uint64_t i) {
+        d_points[i] = (*points)[i];
+        if (u != nullptr) d_points[i] += (*u)[i];
+      });
+  f.get();
+
+  // bounding box
+  auto x_min = d_points[0];
+  auto x_max = d_points[0];
+  for (const auto &x : d_points)
+    for (size_t dof = 0; dof < 3; dof++) {
+      x_min[dof] = std::min(x_min[dof], x[dof]);
+      x_max[dof] = std::max(x_max[dof], x[dof]);
+    }
+  d_xMin = x_min;
+
+  // cell size: keep the number of cells comparable to number of points so
+  // that memory of the grid is bounded for scattered points
+  d_cellSize = cell_size > 0. ? cell_size : 1.;
+  double max_ext = std::max({x_max[0] - x_min[0], x_max[1] - x_min[1],
+                             x_max[2] - x_min[2]});
+  if (max_ext > 0. && d_cellSize > max_ext) d_cellSize = max_ext;
+  while (true) {
+    double num_cells = 1.;
+    for (size_t dof = 0; dof < 3; dof++)
+      num_cells *= std::floor((x_max[dof] - x_min[dof]) / d_cellSize) + 1.;
+
+    if (num_cells <= 8. * double(n) + 64.) break;
+    d_cellSize *= std::max(1.1, std::cbrt(num_cells / (8. * double(n))));
+  }
+  for (size_t dof = 0; dof < 3; dof++)
+    d_numCells[dof] =
+        long(std::floor((x_max[dof] - x_min[dof]) / d_cellSize)) + 1;
+
+  // cell of each point
+  std::vector<size_t> point_cells(n, 0);
+  auto g = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0, n,
+      [this, &point_cells](boost::uint64_t i) {
+        long int c[3];
+        cellCoords(d_points[i], c);
+        point_cells[i] = cellId(c);
+      });
+  g.get();
+
+  // sort points by cells (counting sort keeps the points in a cell in
+  // ascending order of ids)
+  size_t num_cells = size_t(d_numCells[0] * d_numCells[1] * d_numCells[2]);
+  d_cellStart = std::vector<size_t>(num_cells + 1, 0);
+  for (auto c : point_cells) d_cellStart[c + 1]++;
+  for (size_t c = 0; c < num_cells; c++) d_cellStart[c + 1] += d_cellStart[c];
+
+  d_cellPoints.resize(n);
+  auto loc = std::vector<size_t>(d_cellStart.begin(), d_cellStart.end() - 1);
+  for (size_t i = 0; i < n; i++) d_cellPoints[loc[point_cells[i]]++] = i;
+}
+
+void util::PointGrid::cellCoords(const util::Point3 &x, long int *c) const {
+  for (size_t dof = 0; dof < 3; dof++) {
+    double a = std::floor((x[dof] - d_xMin[dof]) / d_cellSize);
+    if (!(a > 0.))
+      c[dof] = 0;
+    else if (a >= double(d_numCells[dof] - 1))
+      c[dof] = d_numCells[dof] - 1;
+    else
+      c[dof] = long(a);
+  }
+}
+
+long int util::PointGrid::findClosest(const util::Point3 &x,
+                                      const double &max_dist) const {
+  if (d_points.empty()) return -1;
+
+  long int c0[3];
+  cellCoords(x, c0);
+  long int max_r = std::max({d_numCells[0], d_numCells[1], d_numCells[2]});
+
+  long int i_found = -1;
+  double dist = max_dist;
+  auto check_cell = [this, &x, &i_found, &dist](const long int *c) {
+    auto id = cellId(c);
+    for (size_t k = d_cellStart[id]; k < d_cellStart[id + 1]; k++) {
+      auto i = d_cellPoints[k];
+      double d = x.dist(d_points[i]);
+      if (d < dist || (i_found >= 0 && d == dist && long(i) < i_found)) {
+        dist = d;
+        i_found = long(i);
+      }
+    }
+  };
+
+  // search over shells of cells around the cell of x; points in shell r + 1
+  // are at least r * cell size away from x
+  for (long int r = 0; r <= max_r; r++) {
+    long int c[3];
+    for (c[2] = std::max(0L, c0[2] - r);
+         c[2] <= std::min(d_numCells[2] - 1, c0[2] + r); c[2]++)
+      for (c[1] = std::max(0L, c0[1] - r);
+           c[1] <= std::min(d_numCells[1] - 1, c0[1] + r); c[1]++) {
+        if (std::abs(c[2] - c0[2]) == r || std::abs(c[1] - c0[1]) == r) {
+          for (c[0] = std::max(0L, c0[0] - r);
+               c[0] <= std::min(d_numCells[0] - 1, c0[0] + r); c[0]++)
+            check_cell(c);
+        } else {
+          c[0] = c0[0] - r;
+          if (c[0] >= 0) check_cell(c);
+          c[0] = c0[0] + r;
+          if (r > 0 && c[0] < d_numCells[0]) check_cell(c);
+        }
+      }
+
+    if (dist <= double(r) * d_cellSize) break;
+  }
+
+  return i_found;
+}
+
+long int util::PointGrid::findClosest(const util::Point3 &x) const {
+  return findClosest(x, std::numeric_limits<double>::max());
+}
+
+void util::PointGrid::findInBall(const util::Point3 &x, const double &r,
+                                 std::vector<size_t> *list) const {
+  list->clear();
+  if (d_points.empty()) return;
+
+  long int c_min[3], c_max[3];
+  cellCoords(x - r, c_min);
+  cellCoords(x + r, c_max);
+
+  long int c[3];
+  for (c[2] = c_min[2]; c[2] <= c_max[2]; c[2]++)
+    for (c[1] = c_min[1]; c[1] <= c_max[1]; c[1]++)
+      for (c[0] = c_min[0]; c[0] <= c_max[0]; c[0]++) {
+        auto id = cellId(c);
+        for (size_t k = d_cellStart[id]; k < d_cellStart[id + 1]; k++)
+          if (x.dist(d_points[d_cellPoints[k]]) <= r)
+            list->push_back(d_cellPoints[k]);
+      }
+
+  std::sort(list->begin(), list->end());
+}
+
+void util::PointGrid::findInBox(const util::Point3 &x_min,
+                                const util::Point3 &x_max,
+                                std::vector<size_t> *list) const {
+  list->clear();
+  if (d_points.empty()) return;
+
+  long int c_min[3], c_max[3];
+  cellCoords(x_min, c_min);
+  cellCoords(x_max, c_max);
+
+  long int c[3];
+  for (c[2] = c_min[2]; c[2] <= c_max[2]; c[2]++)
+    for (c[1] = c_min[1]; c[1] <= c_max[1]; c[1]++)
+      for (c[0] = c_min[0]; c[0] <= c_max[0]; c[0]++) {
+        auto id = cellId(c);
+        for (size_t k = d_cellStart[id]; k < d_cellStart[id + 1]; k++) {
+          const auto &y = d_points[d_cellPoints[k]];
+          if (y.d_x >= x_min.d_x && y.d_x <= x_max.d_x &&
+              y.d_y >= x_min.d_y && y.d_y <= x_max.d_y &&
+              y.d_z >= x_min.d_z && y.d_z <= x_max.d_z)
+            list->push_back(d_cellPoints[k]);
+        }
+      }
+
+  std::sort(list->begin(), list->end());
+}
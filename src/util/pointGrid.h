@@ -0,0 +1,162 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef UTIL_POINTGRID_H
+#define UTIL_POINTGRID_H
+
+#include "util/point.h" // definition of Point3
+#include <vector>
+
+namespace util {
+
+/*!
+ * @brief Uniform bucket grid for fast spatial queries on a set of points
+ *
+ * Points are sorted into cubic cells of given size covering the bounding box
+ * of the points. Cell contents are stored in compressed form: points of cell
+ * c are d_cellPoints[d_cellStart[c]], ..., d_cellPoints[d_cellStart[c + 1]
+ * - 1]. Closest point and range queries only look at cells near the query
+ * point, so that locating all nodes of one mesh in another mesh is of
+ * linear complexity instead of quadratic.
+ *
+ * The grid stores a copy of the point positions and must be rebuilt if the
+ * points move.
+ */
+class PointGrid {
+
+public:
+  /*! @brief Constructor of empty grid */
+  PointGrid();
+
+  /*!
+   * @brief Constructor
+   *
+   * See build().
+   *
+   * @param points Vector of points
+   * @param cell_size Size of cell (typically mesh size)
+   * @param u Vector of displacement of points (optional)
+   */
+  PointGrid(const std::vector<util::Point3> *points, const double &cell_size,
+            const std::vector<util::Point3> *u = nullptr);
+
+  /*!
+   * @brief Sorts the points into grid
+   *
+   * If displacement u is provided, grid is built over points[i] + u[i].
+   * Cell size is increased if the given size results in large number of
+   * empty cells.
+   *
+   * @param points Vector of points
+   * @param cell_size Size of cell (typically mesh size)
+   * @param u Vector of displacement of points (optional)
+   */
+  void build(const std::vector<util::Point3> *points, const double &cell_size,
+             const std::vector<util::Point3> *u = nullptr);
+
+  /*!
+   * @brief Returns true if grid has no points
+   * @return bool True if empty
+   */
+  bool empty() const { return d_points.empty(); };
+
+  /*!
+   * @brief Get number of points in grid
+   * @return N Number of points
+   */
+  size_t getNumPoints() const { return d_points.size(); };
+
+  /*!
+   * @brief Get position of point used in grid
+   * @param i Id of point
+   * @return point Position of point
+   */
+  const util::Point3 &getPoint(const size_t &i) const { return d_points[i]; };
+
+  /*!
+   * @brief Get size of cell
+   * @return size Size of cell
+   */
+  double getCellSize() const { return d_cellSize; };
+
+  /*!
+   * @brief Finds the point closest to x
+   *
+   * If more than one point are at same distance, the one with smaller id is
+   * returned.
+   *
+   * @param x Query point
+   * @param max_dist Search is restricted to points within this distance
+   * @return id Id of closest point or -1 if no point is found
+   */
+  long int findClosest(const util::Point3 &x, const double &max_dist) const;
+
+  /*!
+   * @brief Finds the point closest to x (no restriction on distance)
+   * @param x Query point
+   * @return id Id of closest point or -1 if grid is empty
+   */
+  long int findClosest(const util::Point3 &x) const;
+
+  /*!
+   * @brief Finds all points within distance r of x
+   * @param x Query point
+   * @param r Radius of ball
+   * @param list List of point ids in ascending order
+   */
+  void findInBall(const util::Point3 &x, const double &r,
+                  std::vector<size_t> *list) const;
+
+  /*!
+   * @brief Finds all points inside the box [x_min, x_max]
+   * @param x_min Lower corner of box
+   * @param x_max Upper corner of box
+   * @param list List of point ids in ascending order
+   */
+  void findInBox(const util::Point3 &x_min, const util::Point3 &x_max,
+                 std::vector<size_t> *list) const;
+
+private:
+  /*!
+   * @brief Computes cell coordinates of point (clamped to grid)
+   * @param x Point
+   * @param c Cell coordinates
+   */
+  void cellCoords(const util::Point3 &x, long int *c) const;
+
+  /*!
+   * @brief Get linear cell id from cell coordinates
+   * @param c Cell coordinates
+   * @return id Cell id
+   */
+  size_t cellId(const long int *c) const {
+    return size_t(c[0] + d_numCells[0] * (c[1] + d_numCells[1] * c[2]));
+  };
+
+  /*! @brief Size of cell */
+  double d_cellSize;
+
+  /*! @brief Lower corner of grid */
+  util::Point3 d_xMin;
+
+  /*! @brief Number of cells in each direction */
+  long int d_numCells[3];
+
+  /*! @brief Positions of points */
+  std::vector<util::Point3> d_points;
+
+  /*! @brief Location of first point of cell in d_cellPoints */
+  std::vector<size_t> d_cellStart;
+
+  /*! @brief Ids of points sorted by cell */
+  std::vector<size_t> d_cellPoints;
+};
+
+} // namespace util
+
+#endif // UTIL_POINTGRID_H
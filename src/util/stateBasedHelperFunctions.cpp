@@ -52,8 +52,8 @@ void util::StateBasedHelperFunctions::dilatation(data::DataManager *dataManager,
                   (1. / (*dataManager->getVolumeCorrectionP()
                               ->d_weightedVolume_p)[i]) *
                   w * X.length() * (*dataManager->getExtensionP())[i][k] *
-                  (*dataManager->getVolumeCorrectionP()
-                        ->d_volumeCorrection_p)[i][k] *
+                  dataManager->getVolumeCorrectionP()->getVolumeCorrection(
+                      i, k) *
                   (dataManager->getMeshP()->getNodalVolume(j));
               break;
             case 2:
@@ -62,8 +62,8 @@ void util::StateBasedHelperFunctions::dilatation(data::DataManager *dataManager,
                               ->d_weightedVolume_p)[i]) *
                   factor * w * X.length() *
                   (*dataManager->getExtensionP())[i][k] *
-                  (*dataManager->getVolumeCorrectionP()
-                        ->d_volumeCorrection_p)[i][k] *
+                  dataManager->getVolumeCorrectionP()->getVolumeCorrection(
+                      i, k) *
                   (dataManager->getMeshP()->getNodalVolume(j));
               break;
             case 3:
@@ -71,8 +71,8 @@ void util::StateBasedHelperFunctions::dilatation(data::DataManager *dataManager,
                   (3. / (*dataManager->getVolumeCorrectionP()
                               ->d_weightedVolume_p)[i]) *
                   w * X.length() * (*dataManager->getExtensionP())[i][k] *
-                  (*dataManager->getVolumeCorrectionP()
-                        ->d_volumeCorrection_p)[i][k] *
+                  dataManager->getVolumeCorrectionP()->getVolumeCorrection(
+                      i, k) *
                   (dataManager->getMeshP()->getNodalVolume(j));
               break;
           }
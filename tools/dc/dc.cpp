@@ -4,7 +4,7 @@
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt
 
 #include <algorithm>
-#include <hpx/config.hpp>
+#include <hpx/hpx_main.hpp>
 #include <boost/program_options.hpp>
 #include <iostream>
 
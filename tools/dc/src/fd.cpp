@@ -17,6 +17,7 @@
 #include "util/compare.h"
 #include "util/matrix.h"
 #include "util/point.h"
+#include "util/pointGrid.h"
 #include "util/transfomation.h"
 #include "util/utilGeom.h"
 
@@ -53,6 +54,12 @@ struct SimData {
   /*! @brief Current displacement of all nodes */
   std::vector<util::Point3> d_u;
 
+  /*! @brief Grid for search of nodes in reference configuration */
+  util::PointGrid d_refNodeGrid;
+
+  /*! @brief Grid for search of nodes in current configuration */
+  util::PointGrid d_curNodeGrid;
+
   /*! @brief Mesh size */
   double d_h;
 
@@ -275,7 +282,7 @@ util::Point3 getDisplacementOfNode(const util::Point3 &x1, const SimData *sim1,
 
   long int i_found = -1;
 
-  if (read_counter < 1) {
+  if (read_counter <= 1) {
     static int debug_counter = 0;
     static bool debug_el_ids = false;
 
@@ -291,20 +298,17 @@ util::Point3 getDisplacementOfNode(const util::Point3 &x1, const SimData *sim1,
 
     double check = std::sqrt(2.) * 0.5 * h + 0.01 * h;
     double dist = 10.0 * h;
-    for (size_t i = 0; i < mesh2->getNumNodes(); i++) {
-      auto diff = x1 - mesh2->getNode(i);
-
-      if (util::compare::definitelyLessThan(diff.length(), dist)) {
-        dist = diff.length();
-        i_found = i;
-      }
-    }
+    i_found = sim2->d_refNodeGrid.findClosest(x1, dist);
+    if (i_found != -1) dist = x1.dist(mesh2->getNode(i_found));
     if (i_found == -1) {
       std::cerr << "Node closer to x1 = " << x1.printStr()
                 << " not found. h = " << h << ", dist = " << dist
                 << " check = " << check << ".\n";
       exit(1);
     }
+
+    // store the node so that it is reused for subsequent files
+    n2 = i_found;
   } else
     i_found = n2;
 
@@ -348,14 +352,9 @@ util::Point3 getDisplacementOfNodeCurrent(const util::Point3 &x1,
   int i_found = -1;
   double check = std::sqrt(2.) * 0.5 * h + 0.01 * h;
   double dist = 10.0 * h;
-  for (size_t i = 0; i < mesh2->getNumNodes(); i++) {
-    auto diff = x1 - (sim2->d_y[i] + mesh2->getNode(i));
-
-    if (util::compare::definitelyLessThan(diff.length(), dist)) {
-      dist = diff.length();
-      i_found = i;
-    }
-  }
+  i_found = sim2->d_curNodeGrid.findClosest(x1, dist);
+  if (i_found != -1)
+    dist = x1.dist(sim2->d_curNodeGrid.getPoint(i_found));
   if (i_found == -1) {
     std::cerr << "Node closer to x1 = " << x1.printStr()
               << " not found. h = " << h << ", dist = " << dist
@@ -448,6 +447,9 @@ void compute(bool read_12, const YAML::Node &config) {
 
         // create mesh
         sim2.d_mesh_p = new fe::Mesh(&mdeck);
+
+        // sort nodes into grid for search of nodes close to points of mesh 1
+        sim2.d_refNodeGrid.build(sim2.d_mesh_p->getNodesP(), sim2.d_h);
       }
     }
 
@@ -491,6 +493,11 @@ void compute(bool read_12, const YAML::Node &config) {
           for (size_t i = 0; i < sim2.d_mesh_p->getNumNodes(); i++)
             sim2.d_u[i] = sim2.d_y[i] - sim2.d_mesh_p->getNode(i);
         }
+
+        // update grid for search in current configuration
+        if (dc.d_diffAtCurrent)
+          sim2.d_curNodeGrid.build(&sim2.d_y, sim2.d_h,
+                                   sim2.d_mesh_p->getNodesP());
       }
 
       // initialize the saved nodes data
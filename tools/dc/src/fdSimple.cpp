@@ -9,12 +9,16 @@
 #include <fe/triElem.h>
 #include <util/feElementDefs.h>
 
+#include <algorithm>
+#include <cmath>
+#include <hpx/include/parallel_algorithm.hpp>
 #include <limits>
 
 #include "dcInclude.h"
 #include "fe/mesh.h"
 #include "inp/decks/meshDeck.h"
 #include "rw/reader.h"
+#include "rw/vtkReader.h"
 #include "rw/writer.h"
 #include "util/compare.h"
 #include "util/matrix.h"
@@ -29,21 +33,39 @@ static bool error = false;
 /*! @brief Local namespace */
 namespace fdSimple {
 
+/*! @brief Number of nodes processed by one task when computing norms */
+const size_t block_size = 4096;
+
+/*! @brief Norms of difference of data in two files */
+struct ErrData {
+  /*! @brief L2 norm of difference */
+  double d_l2;
+
+  /*! @brief Sup norm of difference */
+  double d_sup;
+
+  /*! @brief L2 norm of difference relative to L2 norm of data in file 1 */
+  double d_rel;
+
+  ErrData() : d_l2(0.), d_sup(0.), d_rel(0.){};
+};
+
 /*! @brief Read input files
  *
  * @param dim Dimension
- * @param filename1 Simulation data 1
- * @param filename2 Simulation data 2
+ * @param filename1 Simulation data 1 (or prefix of files)
+ * @param filename2 Simulation data 2 (or prefix of files)
  * @param out_filename Output filename
  * @param print_screen Data should or should not be printed to screen
  * @param compare_tags List of tags data which should be compared
  * @param tolerance
+ * @param files List of output numbers if comparing batch of files
  * @param config YAML input file
  */
 void readInputFile(size_t &dim, std::string &filename1, std::string &filename2,
                    std::string &out_filename, bool &print_screen,
                    std::vector<std::string> &compare_tags, double &tolerance,
-                   YAML::Node config) {
+                   std::vector<size_t> &files, YAML::Node config) {
   dim = config["Dimension"].as<size_t>();
 
   filename1 = config["Filename_1"].as<std::string>();
@@ -66,6 +88,203 @@ void readInputFile(size_t &dim, std::string &filename1, std::string &filename2,
                  "compared.\n";
     exit(1);
   }
+
+  files.clear();
+  if (config["Files"]) {
+    auto e = config["Files"];
+    size_t start = e["Start"] ? e["Start"].as<size_t>() : 0;
+    size_t interval = e["Interval"] ? e["Interval"].as<size_t>() : 1;
+    if (!e["End"] || interval == 0) {
+      std::cerr << "Error: Please specify End and nonzero Interval of "
+                   "Files.\n";
+      exit(1);
+    }
+    size_t end = e["End"].as<size_t>();
+
+    for (size_t n = start; n <= end; n += interval) files.push_back(n);
+  }
+}
+
+/*!
+ * @brief Reads data of given tag and stores its components node-wise in
+ * flat array
+ *
+ * @param rdr Reader of file
+ * @param filename Name of file (for error message)
+ * @param tag Tag of data
+ * @param data Pointer to flat array of data
+ * @return nc Number of components of data per node
+ */
+size_t readData(rw::reader::VtkReader &rdr, const std::string &filename,
+                const std::string &tag, std::vector<double> *data) {
+  bool found = false;
+  size_t nc = 0;
+
+  if (tag == "Displacement" || tag == "Velocity" || tag == "Force") {
+    std::vector<util::Point3> v;
+    found = rdr.readPointData(tag, &v);
+    nc = 3;
+    data->resize(nc * v.size());
+    for (size_t i = 0; i < v.size(); i++)
+      for (size_t a = 0; a < 3; a++) (*data)[nc * i + a] = v[i][a];
+  } else if (tag == "Strain_Energy" || tag == "Damage_Z" ||
+             tag == "Damage_Phi") {
+    found = rdr.readPointData(tag, data);
+    nc = 1;
+  } else if (tag == "Strain_Tensor" || tag == "Stress_Tensor") {
+    std::vector<util::Matrix33> v;
+    found = rdr.readPointData(tag, &v);
+    nc = 9;
+    data->resize(nc * v.size());
+    for (size_t i = 0; i < v.size(); i++)
+      for (size_t a = 0; a < 3; a++)
+        for (size_t b = 0; b < 3; b++)
+          (*data)[nc * i + 3 * a + b] = v[i](a, b);
+  } else {
+    std::cerr << "Error: Comparison for tag = " << tag
+              << " has not yet been implemented.\n";
+    exit(1);
+  }
+
+  if (!found) {
+    std::cerr << "Error: " << tag
+              << " data can not be found in the file = " << filename
+              << std::endl;
+    exit(1);
+  }
+
+  return nc;
+}
+
+/*!
+ * @brief Computes norms of difference of data in two files
+ *
+ * Each file is read once and all tags are compared in a single parallel
+ * pass over nodes. Difference at node is the Euclidean (Frobenius for
+ * tensors) norm of difference of data at node.
+ *
+ * @param filename1 Simulation data 1
+ * @param filename2 Simulation data 2
+ * @param compare_tags List of tags data which should be compared
+ * @return errs Norms for each tag
+ */
+std::vector<fdSimple::ErrData> compareFiles(
+    const std::string &filename1, const std::string &filename2,
+    const std::vector<std::string> &compare_tags) {
+  auto rdr1 = rw::reader::VtkReader(filename1);
+  auto rdr2 = rw::reader::VtkReader(filename2);
+
+  // nodes current position
+  std::vector<util::Point3> nodes_current_1;
+  rdr1.readNodes(&nodes_current_1);
+  std::vector<util::Point3> nodes_current_2;
+  rdr2.readNodes(&nodes_current_2);
+
+  // check if size match
+  if (nodes_current_1.size() != nodes_current_2.size()) {
+    std::cerr << "Error: Two files have different number of nodes.\n";
+    exit(1);
+  }
+  size_t nnodes = nodes_current_1.size();
+
+  // read data of all tags
+  size_t nt = compare_tags.size();
+  std::vector<std::vector<double>> data_1(nt);
+  std::vector<std::vector<double>> data_2(nt);
+  std::vector<size_t> nc(nt, 0);
+  for (size_t t = 0; t < nt; t++) {
+    nc[t] = readData(rdr1, filename1, compare_tags[t], &data_1[t]);
+    readData(rdr2, filename2, compare_tags[t], &data_2[t]);
+
+    if (data_1[t].size() != nc[t] * nnodes ||
+        data_2[t].size() != nc[t] * nnodes) {
+      std::cerr << "Error: Size of " << compare_tags[t]
+                << " data does not match the number of nodes.\n";
+      exit(1);
+    }
+  }
+
+  rdr1.close();
+  rdr2.close();
+
+  // partial sums of squared difference, squared data, and maximum of
+  // squared difference for each block of nodes and each tag
+  size_t num_blocks = (nnodes + block_size - 1) / block_size;
+  std::vector<double> block_l2(num_blocks * nt, 0.);
+  std::vector<double> block_norm(num_blocks * nt, 0.);
+  std::vector<double> block_sup(num_blocks * nt, 0.);
+
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      num_blocks,
+      [&data_1, &data_2, &nc, &block_l2, &block_norm, &block_sup, nnodes,
+       nt](boost::uint64_t k) {
+        size_t i_end = std::min(nnodes, (k + 1) * block_size);
+        for (size_t t = 0; t < nt; t++) {
+          const double *a = data_1[t].data();
+          const double *b = data_2[t].data();
+          const size_t n = nc[t];
+
+          double l2 = 0.;
+          double norm = 0.;
+          double sup = 0.;
+          for (size_t i = k * block_size; i < i_end; i++) {
+            double d2 = 0.;
+            for (size_t c = n * i; c < n * (i + 1); c++) {
+              double d = a[c] - b[c];
+              d2 += d * d;
+              norm += a[c] * a[c];
+            }
+            l2 += d2;
+            sup = std::max(sup, d2);
+          }
+
+          block_l2[k * nt + t] = l2;
+          block_norm[k * nt + t] = norm;
+          block_sup[k * nt + t] = sup;
+        }
+      });  // parallel loop over blocks
+  f.get();
+
+  std::vector<fdSimple::ErrData> errs(nt);
+  for (size_t t = 0; t < nt; t++) {
+    double l2 = 0.;
+    double norm = 0.;
+    double sup = 0.;
+    for (size_t k = 0; k < num_blocks; k++) {
+      l2 += block_l2[k * nt + t];
+      norm += block_norm[k * nt + t];
+      sup = std::max(sup, block_sup[k * nt + t]);
+    }
+
+    errs[t].d_l2 = std::sqrt(l2);
+    errs[t].d_sup = std::sqrt(sup);
+    errs[t].d_rel = util::compare::definitelyGreaterThan(norm, 0.)
+                        ? std::sqrt(l2 / norm)
+                        : errs[t].d_l2;
+  }
+
+  return errs;
+}
+
+/*!
+ * @brief Appends norms to output and checks them against tolerance
+ * @param errs Norms for each tag
+ * @param tolerance Tolerance for L2 norm
+ * @param oss Output stream
+ */
+void appendErrors(const std::vector<fdSimple::ErrData> &errs,
+                  const double &tolerance, std::ostringstream &oss) {
+  for (size_t t = 0; t < errs.size(); t++) {
+    if (!util::compare::definitelyLessThan(errs[t].d_l2, tolerance))
+      error = true;
+
+    oss << errs[t].d_l2 << ", " << errs[t].d_sup << ", " << errs[t].d_rel;
+
+    // handle special cases
+    if (t < errs.size() - 1) oss << ", ";
+  }
+  oss << "\n";
 }
 
 //
@@ -85,9 +304,11 @@ void compute(const YAML::Node &config) {
 
   std::vector<std::string> compare_tags;
 
+  std::vector<size_t> files;
+
   // read file
   fdSimple::readInputFile(dim, filename1, filename2, out_filename, print_screen,
-                          compare_tags, tolerance, config);
+                          compare_tags, tolerance, files, config);
 
   // create output file stream
   FILE *file_out = fopen(out_filename.c_str(), "w");
@@ -96,8 +317,10 @@ void compute(const YAML::Node &config) {
   size_t s_counter = 0;
 
   std::ostringstream oss;
+  if (!files.empty()) oss << "File, ";
   for (const auto &s : compare_tags) {
-    oss << s.c_str() << "_L2_Error, " << s.c_str() << "_Sup_Error";
+    oss << s.c_str() << "_L2_Error, " << s.c_str() << "_Sup_Error, "
+        << s.c_str() << "_Rel_Error";
 
     // handle special cases
     if (s_counter < compare_tags.size() - 1) oss << ", ";
@@ -116,281 +339,30 @@ void compute(const YAML::Node &config) {
   oss.str("");
   oss.clear();
 
-  // read filename 1
-  // nodes current position
-  std::vector<util::Point3> nodes_current_1;
-  rw::reader::readVtuFileNodes(filename1, dim, &nodes_current_1, false);
-
-  // read filename 2
-  // nodes current position
-  std::vector<util::Point3> nodes_current_2;
-  rw::reader::readVtuFileNodes(filename2, dim, &nodes_current_2, false);
-
-  // check if size match
-  if (nodes_current_1.size() != nodes_current_2.size()) {
-    std::cerr << "Error: Two files have different number of nodes.\n";
-    exit(1);
-  }
-
-  // loop over tags and compute the error for each tag
-  s_counter = 0;
-  for (const auto &tag : compare_tags) {
-    // implement specific cases
-
-    if (tag == "Displacement") {
-      // read displacement from file 1
-      std::vector<util::Point3> nodes_u_1;
-
-      if (!rw::reader::readVtuFilePointData(filename1, tag, &nodes_u_1)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename1 << std::endl;
-        exit(1);
-      }
-
-      // read displacement from file 2
-      std::vector<util::Point3> nodes_u_2;
-
-      if (!rw::reader::readVtuFilePointData(filename2, tag, &nodes_u_2)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename2 << std::endl;
-        exit(1);
-      }
-
-      // compute L2 and sup norm
-      double l2 = 0.;
-      double sup = 0.;
-      for (size_t i = 0; i < nodes_u_1.size(); i++) {
-        auto du = nodes_u_1[i] - nodes_u_2[i];
-        l2 += du.length() * du.length();
-
-        if (util::compare::definitelyGreaterThan(du.length(), sup))
-          sup = du.length();
-      }
-
-      l2 = std::sqrt(l2);
-
-      if (!util::compare::definitelyLessThan(l2, tolerance)) error = true;
-
-      // append data
-      oss << l2 << ", " << sup;
-
-    } else if (tag == "Velocity") {
-      // read displacement from file 1
-      std::vector<util::Point3> nodes_v_1;
-
-      if (!rw::reader::readVtuFilePointData(filename1, tag, &nodes_v_1)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename1 << std::endl;
-        exit(1);
-      }
-
-      // read displacement from file 2
-      std::vector<util::Point3> nodes_v_2;
-
-      if (!rw::reader::readVtuFilePointData(filename2, tag, &nodes_v_2)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename2 << std::endl;
-        exit(1);
-      }
-
-      // compute L2 and sup norm
-      double l2 = 0.;
-      double sup = 0.;
-      for (size_t i = 0; i < nodes_v_1.size(); i++) {
-        auto dv = nodes_v_1[i] - nodes_v_2[i];
-        l2 += dv.length() * dv.length();
-
-        if (util::compare::definitelyGreaterThan(dv.length(), sup))
-          sup = dv.length();
-      }
-
-      l2 = std::sqrt(l2);
-
-      if (!util::compare::definitelyLessThan(l2, tolerance)) error = true;
-
-      // append data
-      oss << l2 << ", " << sup;
-
-    } else if (tag == "Force") {
-      // read displacement from file 1
-      std::vector<util::Point3> nodes_f_1;
-
-      if (!rw::reader::readVtuFilePointData(filename1, tag, &nodes_f_1)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename1 << std::endl;
-        exit(1);
-      }
-
-      // read displacement from file 2
-      std::vector<util::Point3> nodes_f_2;
-
-      if (!rw::reader::readVtuFilePointData(filename2, tag, &nodes_f_2)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename2 << std::endl;
-        exit(1);
-      }
-
-      // compute L2 and sup norm
-      double l2 = 0.;
-      double sup = 0.;
-      for (size_t i = 0; i < nodes_f_1.size(); i++) {
-        auto df = nodes_f_1[i] - nodes_f_2[i];
-        l2 += df.length() * df.length();
-
-        if (util::compare::definitelyGreaterThan(df.length(), sup))
-          sup = df.length();
-      }
-
-      l2 = std::sqrt(l2);
-
-      if (!util::compare::definitelyLessThan(l2, tolerance)) error = true;
-
-      // append data
-      oss << l2 << ", " << sup;
-    } else if (tag == "Strain_Energy") {
-      // read strain energy from file 1
-      std::vector<double> nodes_e_1;
-
-      if (!rw::reader::readVtuFilePointData(filename1, tag, &nodes_e_1)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename1 << std::endl;
-        exit(1);
-      }
-
-      // read strain energy from file 2
-      std::vector<double> nodes_e_2;
-
-      if (!rw::reader::readVtuFilePointData(filename2, tag, &nodes_e_2)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename2 << std::endl;
-        exit(1);
-      }
-
-      // compute L2 and sup norm
-      double l2 = 0.;
-      double sup = 0.;
-      for (size_t i = 0; i < nodes_e_1.size(); i++) {
-        auto df = nodes_e_1[i] - nodes_e_2[i];
-        l2 += df * df;
-
-        if (util::compare::definitelyGreaterThan(df, sup)) sup = df;
-      }
-
-      l2 = std::sqrt(l2);
-
-      if (!util::compare::definitelyLessThan(l2, tolerance)) error = true;
-
-      // append data
-      oss << l2 << ", " << sup;
-
-    } else if (tag == "Strain_Tensor") {
-      // read strain tensor from file 1
-      std::vector<util::Matrix33> nodes_strain_1;
-
-      if (!rw::reader::readVtuFilePointData(filename1, tag, &nodes_strain_1)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename1 << std::endl;
-        exit(1);
-      }
-
-      // read displacement from file 2
-      std::vector<util::Matrix33> nodes_strain_2;
-
-      if (!rw::reader::readVtuFilePointData(filename2, tag, &nodes_strain_2)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename2 << std::endl;
-        exit(1);
-      }
-
-      // compute L2 and sup norm
-      double l2 = 0.;
-      double sup = 0.;
-      for (size_t i = 0; i < nodes_strain_1.size(); i++) {
-        auto df = blaze::sum(nodes_strain_1[i] - nodes_strain_2[i]);
-        l2 += df * df;
-
-        if (util::compare::definitelyGreaterThan(df, sup)) sup = df;
-      }
-
-      l2 = std::sqrt(l2);
-
-      if (!util::compare::definitelyLessThan(l2, tolerance)) error = true;
-
-      // append data
-      oss << l2 << ", " << sup;
-
-    } else if (tag == "Stress_Tensor") {
-      // read strain tensor from file 1
-      std::vector<util::Matrix33> nodes_strain_1;
-
-      if (!rw::reader::readVtuFilePointData(filename1, tag, &nodes_strain_1)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename1 << std::endl;
-        exit(1);
-      }
-
-      // read displacement from file 2
-      std::vector<util::Matrix33> nodes_strain_2;
-
-      if (!rw::reader::readVtuFilePointData(filename2, tag, &nodes_strain_2)) {
-        std::cerr << "Error: " << tag
-                  << " data can not be found in the file ="
-                     " "
-                  << filename2 << std::endl;
-        exit(1);
-      }
-
-      // compute L2 and sup norm
-      double l2 = 0.;
-      double sup = 0.;
-      for (size_t i = 0; i < nodes_strain_1.size(); i++) {
-        auto df = blaze::sum(nodes_strain_1[i] - nodes_strain_2[i]);
-        l2 += df * df;
-
-        if (util::compare::definitelyGreaterThan(df, sup)) sup = df;
-      }
-
-      l2 = std::sqrt(l2);
-
-      if (!util::compare::definitelyLessThan(l2, tolerance)) error = true;
-
-      // append data
-      oss << l2 << ", " << sup;
-
-    } else {
-      std::cerr << "Error: Comparison for tag = " << tag
-                << " has not yet been implemented.\n";
-      exit(1);
+  if (files.empty()) {
+    auto errs = fdSimple::compareFiles(filename1, filename2, compare_tags);
+    fdSimple::appendErrors(errs, tolerance, oss);
+  } else {
+    // batch of files are compared in parallel and results are written in
+    // order of files
+    std::vector<std::vector<fdSimple::ErrData>> errs(files.size());
+    auto f = hpx::parallel::for_loop(
+        hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+        files.size(),
+        [&errs, &files, &filename1, &filename2,
+         &compare_tags](boost::uint64_t i) {
+          auto n = std::to_string(files[i]);
+          errs[i] = fdSimple::compareFiles(filename1 + n + ".vtu",
+                                           filename2 + n + ".vtu",
+                                           compare_tags);
+        });
+    f.get();
+
+    for (size_t i = 0; i < files.size(); i++) {
+      oss << files[i] << ", ";
+      fdSimple::appendErrors(errs[i], tolerance, oss);
     }
-
-    // handle special cases
-    if (s_counter < compare_tags.size() - 1) oss << ", ";
-
-    s_counter++;
   }
-  oss << "\n";
 
   fprintf(file_out, "%s", oss.str().c_str());
   if (print_screen) std::cout << oss.str();
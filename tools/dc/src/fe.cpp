@@ -17,6 +17,7 @@
 #include "util/compare.h"
 #include "util/matrix.h"
 #include "util/point.h"
+#include "util/pointGrid.h"
 #include "util/transfomation.h"
 #include "util/utilGeom.h"
 
@@ -53,6 +54,12 @@ struct SimData {
   /*! @brief Current displacement of all nodes */
   std::vector<util::Point3> d_u;
 
+  /*! @brief Grid for search of nodes in reference configuration */
+  util::PointGrid d_refNodeGrid;
+
+  /*! @brief Grid for search of nodes in current configuration */
+  util::PointGrid d_curNodeGrid;
+
   /*! @brief Mesh size */
   double d_h;
 
@@ -299,14 +306,8 @@ util::Point3 getDisplacementAtQuadPoint(
     int i_found = -1;
     double check = std::sqrt(2.) * 0.5 * h + 0.01 * h;
     double dist = 10.0 * h;
-    for (size_t i = 0; i < mesh2->getNumNodes(); i++) {
-      auto diff = x1 - mesh2->getNode(i);
-
-      if (util::compare::definitelyLessThan(diff.length(), dist)) {
-        dist = diff.length();
-        i_found = i;
-      }
-    }
+    i_found = sim2->d_refNodeGrid.findClosest(x1, dist);
+    if (i_found != -1) dist = x1.dist(mesh2->getNode(i_found));
     if (i_found == -1) {
       std::cerr << "Node closer to x = " << x1.printStr() << " not found."
                 << " h = " << h << ", dist = " << dist << ", check = " << check
@@ -340,7 +341,7 @@ util::Point3 getDisplacementAtQuadPoint(
 
     auto xi = mesh2->getNode(i_found);
     auto yi = sim2->d_y[i_found];
-    auto i_elems = mesh2->getElementConnectivity(i_found);
+    auto i_elems = mesh2->getNodeElementConnectivity(i_found);
     int e_found = -1;
     for (unsigned long e_id : i_elems) {
       auto e_nodes = mesh2->getElementConnectivity(e_id);
@@ -587,14 +588,9 @@ util::Point3 getDisplacementAtQuadPointCurrentSimple(
   int i_found = -1;
   double check = std::sqrt(2.) * 0.5 * h + 0.01 * h;
   double dist = 10.0 * h;
-  for (size_t i = 0; i < mesh2->getNumNodes(); i++) {
-    auto diff = x1 - (sim2->d_y[i] + mesh2->getNode(i));
-
-    if (util::compare::definitelyLessThan(diff.length(), dist)) {
-      dist = diff.length();
-      i_found = i;
-    }
-  }
+  i_found = sim2->d_curNodeGrid.findClosest(x1, dist);
+  if (i_found != -1)
+    dist = x1.dist(sim2->d_curNodeGrid.getPoint(i_found));
   if (i_found == -1) {
     std::cerr << "Node closer to x1 = " << x1.printStr()
               << " not found. h = " << h << ", dist = " << dist
@@ -633,7 +629,13 @@ void compute(bool read_12, const YAML::Node &config) {
   //
   // data for mesh 1 (fine mesh)
   //
-  std::vector<std::vector<fe::QuadData>> qd_data1;
+  // Quadrature data of element e is stored contiguously at
+  // qd_data1[e * num_qds], num_qds being the number of quadrature points
+  // per element
+  //
+  auto tri = fe::TriElem(dc.d_numQuads);
+  const size_t num_qds = tri.getRefQuadDatas().size();
+  std::vector<fe::TriElem::QuadDataT> qd_data1;
 
   //
   // Data to store elements searched in first call. These elements are in
@@ -695,6 +697,9 @@ void compute(bool read_12, const YAML::Node &config) {
 
         // create mesh
         sim2.d_mesh_p = new fe::Mesh(&mdeck);
+
+        // sort nodes into grid for search of nodes close to points of mesh 1
+        sim2.d_refNodeGrid.build(sim2.d_mesh_p->getNodesP(), sim2.d_h);
       }
     }
 
@@ -738,20 +743,29 @@ void compute(bool read_12, const YAML::Node &config) {
           for (size_t i = 0; i < sim2.d_mesh_p->getNumNodes(); i++)
             sim2.d_u[i] = sim2.d_y[i] - sim2.d_mesh_p->getNode(i);
         }
+
+        // update grid for search in current configuration
+        if (dc.d_diffAtCurrent)
+          sim2.d_curNodeGrid.build(&sim2.d_y, sim2.d_h,
+                                   sim2.d_mesh_p->getNodesP());
       }
 
       // resize dummy element list
       if (read_counter == 1 && !dc.d_isFd) {
-        // els_fm is of the size of fine mesh
-        qd_data1.resize(sim1.d_mesh_p->getNumElements());
+        if (sim1.d_mesh_p->getElementType() != util::vtk_type_triangle) {
+          std::cerr << "Error: Only triangle element is supported in data "
+                       "comparison"
+                    << std::endl;
+          exit(1);
+        }
+
+        // quadrature data of all elements of fine mesh
+        qd_data1.resize(sim1.d_mesh_p->getNumElements() * num_qds);
 
         // els_cm_of_qpts is also of the size of fine mesh
         els_cm_of_qpts.resize(sim1.d_mesh_p->getNumElements());
-
-        // allocate enough space to inner vector
-        // Max number of quad points is 12 (increase this if needed)
         for (auto &els_cm_of_qpt : els_cm_of_qpts)
-          els_cm_of_qpt = std::vector<size_t>(12, 0);
+          els_cm_of_qpt = std::vector<size_t>(num_qds, 0);
       }
 
       // get alias for mesh 1 and mesh 2
@@ -765,39 +779,18 @@ void compute(bool read_12, const YAML::Node &config) {
       for (size_t e = 0; e < mesh1->getNumElements(); e++) {
         auto e_nodes = mesh1->getElementConnectivity(e);
 
-        // compute quad points on copy of current element
-        std::vector<fe::QuadData> e_quads;
+        // quad data of element (computed in first reading and reused)
+        auto *e_quads = &qd_data1[e * num_qds];
 
         if (read_counter == 1) {
-          // create node data for quad function
-          std::vector<util::Point3> nodes_d;
-          for (unsigned long n : e_nodes) {
-            nodes_d.push_back(mesh1->getNode(n));
-          }
-
-          // call quad function
-          if (mesh1->getElementType() == util::vtk_type_triangle) {
-            auto tri = fe::TriElem(dc.d_numQuads);
-            e_quads = tri.getQuadPoints(nodes_d);
-          } else {
-            std::cerr << "Error: Only triangle element is supported in data "
-                         "comparison"
-                      << std::endl;
-            exit(1);
-          }
-
-          // created temp_el with quad data so now push it to
-          // dummy list for reuse next time
-          qd_data1[e] = e_quads;
-
-          // resize inner size of els_cm_of_qpts
-          if (els_cm_of_qpts[e].size() != e_quads.size())
-            els_cm_of_qpts[e] = std::vector<size_t>(e_quads.size(), 0);
-        } else
-          e_quads = qd_data1[e];
+          const util::Point3 nodes_d[3] = {mesh1->getNode(e_nodes[0]),
+                                           mesh1->getNode(e_nodes[1]),
+                                           mesh1->getNode(e_nodes[2])};
+          tri.getQuadDatas(nodes_d, e_quads);
+        }
 
         // loop over quad points
-        for (size_t q = 0; q < e_quads.size(); q++) {
+        for (size_t q = 0; q < num_qds; q++) {
           auto xq = e_quads[q].d_p;
 
           // get displacement and current position of quad point
@@ -8,7 +8,9 @@
 
 #include "src/1d/fe1D.h"
 #include "src/2d/fe2D.h"
+#include "src/3d/fe3D.h"
 #include <algorithm>
+#include <hpx/hpx_main.hpp>
 #include <boost/program_options.hpp>
 #include <iostream>
 
@@ -50,6 +52,7 @@ int main(int argc, char *argv[]) {
 
   if (dim == 1) tools::mesh::fe1D(filename);
   if (dim == 2) tools::mesh::fe2D(filename);
+  if (dim == 3) tools::mesh::fe3D(filename);
 
   return EXIT_SUCCESS;
 }
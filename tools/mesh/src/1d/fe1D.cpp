@@ -11,6 +11,7 @@
 #include "util/point.h"          // definition of Point3
 #include "util/feElementDefs.h"  // definition of fe element type
 #include <cmath>
+#include <hpx/include/parallel_algorithm.hpp>
 #include <iostream>
 #include <yaml-cpp/yaml.h>  // YAML reader
 
@@ -114,15 +115,18 @@ void tools::mesh::fe1D(const std::string &filename) {
   size_t element_type = util::vtk_type_line;
   std::vector<size_t> en_con(2 * num_elems, 0);
 
-  // create nodes
-  for (size_t i = 0; i < num_nodes; i++)
-    nodes[i].d_x = data.d_domain.first + i * data.d_h;
-
-  // create element-node connectivity
-  for (size_t i = 0; i < num_elems; i++) {
-    en_con[2 * i] = i;
-    en_con[2 * i + 1] = i + 1;
-  }
+  // create nodes and element-node connectivity
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      num_nodes, [&nodes, &en_con, &data, num_elems](boost::uint64_t i) {
+        nodes[i].d_x = data.d_domain.first + i * data.d_h;
+
+        if (i < num_elems) {
+          en_con[2 * i] = i;
+          en_con[2 * i + 1] = i + 1;
+        }
+      });
+  f.get();
 
   // write to vtu file
   auto writer = rw::writer::Writer(data.d_meshFile, data.d_outFormat,
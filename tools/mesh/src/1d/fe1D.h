@@ -29,9 +29,10 @@ namespace tools {
  * @brief Namespace for simple mesh generation
  *
  * In this namespace we define the methods for generating simple finite
- * element/finite difference mesh in 1-d and 2-d. For finite element, we can
- * specify three types of triangular mesh which differ in how we create
- * triangle on uniform grid.
+ * element/finite difference mesh in 1-d, 2-d and 3-d. For finite element in
+ * 2-d, we can specify three types of triangular mesh which differ in how we
+ * create triangle on uniform grid. In 3-d, hexahedral and tetrahedral mesh
+ * can be created.
  */
 namespace mesh {
 
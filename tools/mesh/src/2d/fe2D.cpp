@@ -12,6 +12,7 @@
 #include "util/feElementDefs.h"  // definition of fe element type
 #include "util/compare.h"        // compare real numbers
 #include <cmath>
+#include <hpx/include/parallel_algorithm.hpp>
 #include <iostream>
 #include <yaml-cpp/yaml.h>  // YAML reader
 
@@ -144,18 +145,22 @@ void tools::mesh::uniformSquare(const std::string &filename) {
   std::vector<util::Point3> nodes(num_nodes, util::Point3());
   std::vector<double> nodal_vols(num_nodes, data.d_h * data.d_h);
 
-  // create nodal data
-  for (size_t j = 0; j <= ny; j++)
-    for (size_t i = 0; i <= nx; i++) {
-      // node number
-      size_t n = j * (nx + 1) + i;
-      nodes[n] =
-          util::Point3(data.d_domain.first[0] + double(i) * data.d_h,
-                       data.d_domain.first[1] + double(j) * data.d_h, 0.);
-
-      if (i == 0 || i == nx) nodal_vols[n] *= 0.5;
-      if (j == 0 || j == ny) nodal_vols[n] *= 0.5;
-    }  // loop over j
+  // create nodal data (rows of nodes are created in parallel)
+  auto f_nodes = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      ny + 1, [&nodes, &nodal_vols, &data, nx, ny](boost::uint64_t j) {
+        for (size_t i = 0; i <= nx; i++) {
+          // node number
+          size_t n = j * (nx + 1) + i;
+          nodes[n] =
+              util::Point3(data.d_domain.first[0] + double(i) * data.d_h,
+                           data.d_domain.first[1] + double(j) * data.d_h, 0.);
+
+          if (i == 0 || i == nx) nodal_vols[n] *= 0.5;
+          if (j == 0 || j == ny) nodal_vols[n] *= 0.5;
+        }  // loop over i
+      });  // loop over j
+  f_nodes.get();
 
   // if this mesh is being generated for finite difference simulation
   // we do not require element-node connectivity
@@ -176,17 +181,21 @@ void tools::mesh::uniformSquare(const std::string &filename) {
   std::vector<size_t> en_con(4 * num_elems, 0);
 
   // create element-node connectivity data
-  for (size_t j = 0; j < ny; j++)
-    for (size_t i = 0; i < nx; i++) {
-      // element number
-      auto n = j * nx + i;
-
-      // element node connectivity (put it in anti clockwise order)
-      en_con[4 * n + 0] = j * (nx + 1) + i;
-      en_con[4 * n + 1] = j * (nx + 1) + i + 1;
-      en_con[4 * n + 2] = (j + 1) * (nx + 1) + i + 1;
-      en_con[4 * n + 3] = (j + 1) * (nx + 1) + i;
-    }
+  auto f_elems = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0, ny,
+      [&en_con, nx](boost::uint64_t j) {
+        for (size_t i = 0; i < nx; i++) {
+          // element number
+          auto n = j * nx + i;
+
+          // element node connectivity (put it in anti clockwise order)
+          en_con[4 * n + 0] = j * (nx + 1) + i;
+          en_con[4 * n + 1] = j * (nx + 1) + i + 1;
+          en_con[4 * n + 2] = (j + 1) * (nx + 1) + i + 1;
+          en_con[4 * n + 3] = (j + 1) * (nx + 1) + i;
+        }
+      });
+  f_elems.get();
 
   // write data to file
   auto writer = rw::writer::Writer(data.d_meshFile, data.d_outFormat,
@@ -256,18 +265,22 @@ void tools::mesh::uniformTri(const std::string &filename) {
   std::vector<util::Point3> nodes(num_nodes, util::Point3());
   std::vector<double> nodal_vols(num_nodes, data.d_h * data.d_h);
 
-  // create nodal data
-  for (size_t j = 0; j <= ny; j++)
-    for (size_t i = 0; i <= nx; i++) {
-      // node number
-      size_t n = j * (nx + 1) + i;
-      nodes[n] =
-          util::Point3(data.d_domain.first[0] + double(i) * data.d_h,
-                       data.d_domain.first[1] + double(j) * data.d_h, 0.);
-
-      if (i == 0 || i == nx) nodal_vols[n] *= 0.5;
-      if (j == 0 || j == ny) nodal_vols[n] *= 0.5;
-    }  // loop over j
+  // create nodal data (rows of nodes are created in parallel)
+  auto f_nodes = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      ny + 1, [&nodes, &nodal_vols, &data, nx, ny](boost::uint64_t j) {
+        for (size_t i = 0; i <= nx; i++) {
+          // node number
+          size_t n = j * (nx + 1) + i;
+          nodes[n] =
+              util::Point3(data.d_domain.first[0] + double(i) * data.d_h,
+                           data.d_domain.first[1] + double(j) * data.d_h, 0.);
+
+          if (i == 0 || i == nx) nodal_vols[n] *= 0.5;
+          if (j == 0 || j == ny) nodal_vols[n] *= 0.5;
+        }  // loop over i
+      });  // loop over j
+  f_nodes.get();
 
   // if this mesh is being generated for finite difference simulation
   // we do not require element-node connectivity
@@ -289,41 +302,45 @@ void tools::mesh::uniformTri(const std::string &filename) {
   std::vector<size_t> en_con(3 * num_elems, 0);
 
   // create element-node connectivity
-  for (size_t j = 0; j < ny; j++)
-    for (size_t i = 0; i < nx; i++) {
-      // get node numbers
-      auto n1 = j * (nx + 1) + i;
-      auto n2 = j * (nx + 1) + i + 1;
-      auto n3 = (j + 1) * (nx + 1) + i;
-      auto n4 = (j + 1) * (nx + 1) + i + 1;
-
-      // get element numbers
-      auto T1 = j * 2 * nx + 2 * i;
-      auto T2 = T1 + 1;
-
-      // element-node connectivity
-      if (i % 2 == 0) {
-        // T1 (anticlockwise order)
-        en_con[3 * T1 + 0] = n1;
-        en_con[3 * T1 + 1] = n4;
-        en_con[3 * T1 + 2] = n3;
-
-        // T2 (anticlockwise order)
-        en_con[3 * T2 + 0] = n1;
-        en_con[3 * T2 + 1] = n2;
-        en_con[3 * T2 + 2] = n4;
-      } else {
-        // T1 (anticlockwise order)
-        en_con[3 * T1 + 0] = n1;
-        en_con[3 * T1 + 1] = n2;
-        en_con[3 * T1 + 2] = n3;
-
-        // T2 (anticlockwise order)
-        en_con[3 * T2 + 0] = n2;
-        en_con[3 * T2 + 1] = n4;
-        en_con[3 * T2 + 2] = n3;
-      }
-    }  // loop over i
+  auto f_elems = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0, ny,
+      [&en_con, nx](boost::uint64_t j) {
+        for (size_t i = 0; i < nx; i++) {
+          // get node numbers
+          auto n1 = j * (nx + 1) + i;
+          auto n2 = j * (nx + 1) + i + 1;
+          auto n3 = (j + 1) * (nx + 1) + i;
+          auto n4 = (j + 1) * (nx + 1) + i + 1;
+
+          // get element numbers
+          auto T1 = j * 2 * nx + 2 * i;
+          auto T2 = T1 + 1;
+
+          // element-node connectivity
+          if (i % 2 == 0) {
+            // T1 (anticlockwise order)
+            en_con[3 * T1 + 0] = n1;
+            en_con[3 * T1 + 1] = n4;
+            en_con[3 * T1 + 2] = n3;
+
+            // T2 (anticlockwise order)
+            en_con[3 * T2 + 0] = n1;
+            en_con[3 * T2 + 1] = n2;
+            en_con[3 * T2 + 2] = n4;
+          } else {
+            // T1 (anticlockwise order)
+            en_con[3 * T1 + 0] = n1;
+            en_con[3 * T1 + 1] = n2;
+            en_con[3 * T1 + 2] = n3;
+
+            // T2 (anticlockwise order)
+            en_con[3 * T2 + 0] = n2;
+            en_con[3 * T2 + 1] = n4;
+            en_con[3 * T2 + 2] = n3;
+          }
+        }  // loop over i
+      });  // loop over j
+  f_elems.get();
 
   // write data to file
   auto writer = rw::writer::Writer(data.d_meshFile, data.d_outFormat,
@@ -430,44 +447,52 @@ void tools::mesh::uniformTriSym(const std::string &filename) {
   std::vector<util::Point3> nodes(num_nodes, util::Point3());
   std::vector<double> nodal_vols(num_nodes, 2. * data.d_h * data.d_h);
 
-  for (size_t j = 0; j <= ny_cell; j++)
-    for (size_t i = 0; i <= nx_cell; i++) {
-      // first node (lattice cite / corner of unit cell)
-
-      // numbering above is as follows
-      //
-      //               n2         n4          n6
-      //                o          o          o        <-- these are center
-      //                                                   of lattice
-      //
-      //         o-----------o---------o------         <--- these are lattice
-      //        n1          n3         n5                   cites
-
-      // for each j, we have nx+1 lattice cites and nx cites at the center
-      // of lattice. nx because for the lattice cite at the right vertical
-      // boundary, we do not have center of lattice cite.
-      // Special case: When j == ny_cell. In this case we do not have any
-      // nodes at the lattice center as we have reached the upper boundary.
-      size_t n = j * (nx_cell + 1 + nx_cell) + 2 * i;
-      if (j == ny_cell) n = j * (nx_cell + 1 + nx_cell) + i;
-
-      // create node
-      nodes[n] = util::Point3(data.d_domain.first[0] + double(i) * h_cell,
-                              data.d_domain.first[1] + double(j) * h_cell, 0.);
-
-      // modify the volume
-      if (i == 0 || i == nx_cell) nodal_vols[n] *= 0.5;
-      if (j == 0 || j == ny_cell) nodal_vols[n] *= 0.5;
-
-      // second node (center of lattice)
-      // create only if i is not at the boundary and j is not at the boundary
-      if (i < nx_cell && j < ny_cell) {
-        n += 1;
-        nodes[n] = util::Point3(
-            data.d_domain.first[0] + double(i) * h_cell + data.d_h,
-            data.d_domain.first[1] + double(j) * h_cell + data.d_h, 0.);
-      }
-    }  // loop over i
+  // create nodal data (rows of unit cells are created in parallel)
+  auto f_nodes = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      ny_cell + 1,
+      [&nodes, &nodal_vols, &data, h_cell, nx_cell,
+       ny_cell](boost::uint64_t j) {
+        for (size_t i = 0; i <= nx_cell; i++) {
+          // first node (lattice cite / corner of unit cell)
+
+          // numbering above is as follows
+          //
+          //          n2         n4          n6
+          //           o          o          o        <-- these are center
+          //                                              of lattice
+          //
+          //    o-----------o---------o------         <--- these are lattice
+          //   n1          n3         n5                   cites
+
+          // for each j, we have nx+1 lattice cites and nx cites at the center
+          // of lattice. nx because for the lattice cite at the right vertical
+          // boundary, we do not have center of lattice cite.
+          // Special case: When j == ny_cell. In this case we do not have any
+          // nodes at the lattice center as we have reached the upper boundary.
+          size_t n = j * (nx_cell + 1 + nx_cell) + 2 * i;
+          if (j == ny_cell) n = j * (nx_cell + 1 + nx_cell) + i;
+
+          // create node
+          nodes[n] =
+              util::Point3(data.d_domain.first[0] + double(i) * h_cell,
+                           data.d_domain.first[1] + double(j) * h_cell, 0.);
+
+          // modify the volume
+          if (i == 0 || i == nx_cell) nodal_vols[n] *= 0.5;
+          if (j == 0 || j == ny_cell) nodal_vols[n] *= 0.5;
+
+          // second node (center of lattice)
+          // create only if i and j are not at the boundary
+          if (i < nx_cell && j < ny_cell) {
+            n += 1;
+            nodes[n] = util::Point3(
+                data.d_domain.first[0] + double(i) * h_cell + data.d_h,
+                data.d_domain.first[1] + double(j) * h_cell + data.d_h, 0.);
+          }
+        }  // loop over i
+      });  // loop over j
+  f_nodes.get();
 
   // if this mesh is being generated for finite difference simulation
   // we do not require element-node connectivity
@@ -489,63 +514,67 @@ void tools::mesh::uniformTriSym(const std::string &filename) {
   std::vector<size_t> en_con(3 * num_elems, 0);
 
   // create element-node connectivity
-  for (int j = 0; j < ny_cell; j++)
-    for (int i = 0; i < nx_cell; i++) {
-      //
-      // Each cell consists of 4 triangles and 5 nodes
-      //       n4          n3
-      //         o---------o
-      //         | \ T3  / |
-      //         |  \  /   |
-      //         |T0  o T2 |
-      //         |  /  \   |
-      //         | / T1  \ |
-      //         o---------o
-      //        n0        n2
-      //
-      // center node: n1
-      //
-      // size of cell is 2h
-      //
-      //
-      // get node numbers
-      std::vector<size_t> ns(5, 0);
-      ns[0] = j * (nx_cell + 1 + nx_cell) + 2 * i;
-      ns[1] = ns[0] + 1;
-      ns[2] = ns[0] + 2;
-      // handle special case when j+1 == ny_cell
-      if (j + 1 < ny_cell) {
-        ns[4] = (j + 1) * (nx_cell + 1 + nx_cell) + 2 * i;
-        ns[3] = ns[4] + 2;
-      } else {
-        ns[4] = (j + 1) * (nx_cell + 1 + nx_cell) + i;
-        ns[3] = ns[4] + 1;
-      }
-
-      // T1
-      auto T = j * 4 * nx_cell + 4 * i + 0;
-      en_con[3 * T + 0] = ns[0];
-      en_con[3 * T + 1] = ns[1];
-      en_con[3 * T + 2] = ns[4];
-
-      // T2
-      T = j * 4 * nx_cell + 4 * i + 1;
-      en_con[3 * T + 0] = ns[0];
-      en_con[3 * T + 1] = ns[2];
-      en_con[3 * T + 2] = ns[1];
-
-      // T3
-      T = j * 4 * nx_cell + 4 * i + 2;
-      en_con[3 * T + 0] = ns[1];
-      en_con[3 * T + 1] = ns[2];
-      en_con[3 * T + 2] = ns[3];
-
-      // T4
-      T = j * 4 * nx_cell + 4 * i + 3;
-      en_con[3 * T + 0] = ns[1];
-      en_con[3 * T + 1] = ns[3];
-      en_con[3 * T + 2] = ns[4];
-    }  // loop over i
+  auto f_elems = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      ny_cell, [&en_con, nx_cell, ny_cell](boost::uint64_t j) {
+        for (size_t i = 0; i < nx_cell; i++) {
+          //
+          // Each cell consists of 4 triangles and 5 nodes
+          //       n4          n3
+          //         o---------o
+          //         | \ T3  / |
+          //         |  \  /   |
+          //         |T0  o T2 |
+          //         |  /  \   |
+          //         | / T1  \ |
+          //         o---------o
+          //        n0        n2
+          //
+          // center node: n1
+          //
+          // size of cell is 2h
+          //
+          //
+          // get node numbers
+          std::vector<size_t> ns(5, 0);
+          ns[0] = j * (nx_cell + 1 + nx_cell) + 2 * i;
+          ns[1] = ns[0] + 1;
+          ns[2] = ns[0] + 2;
+          // handle special case when j+1 == ny_cell
+          if (j + 1 < ny_cell) {
+            ns[4] = (j + 1) * (nx_cell + 1 + nx_cell) + 2 * i;
+            ns[3] = ns[4] + 2;
+          } else {
+            ns[4] = (j + 1) * (nx_cell + 1 + nx_cell) + i;
+            ns[3] = ns[4] + 1;
+          }
+
+          // T1
+          auto T = j * 4 * nx_cell + 4 * i + 0;
+          en_con[3 * T + 0] = ns[0];
+          en_con[3 * T + 1] = ns[1];
+          en_con[3 * T + 2] = ns[4];
+
+          // T2
+          T = j * 4 * nx_cell + 4 * i + 1;
+          en_con[3 * T + 0] = ns[0];
+          en_con[3 * T + 1] = ns[2];
+          en_con[3 * T + 2] = ns[1];
+
+          // T3
+          T = j * 4 * nx_cell + 4 * i + 2;
+          en_con[3 * T + 0] = ns[1];
+          en_con[3 * T + 1] = ns[2];
+          en_con[3 * T + 2] = ns[3];
+
+          // T4
+          T = j * 4 * nx_cell + 4 * i + 3;
+          en_con[3 * T + 0] = ns[1];
+          en_con[3 * T + 1] = ns[3];
+          en_con[3 * T + 2] = ns[4];
+        }  // loop over i
+      });  // loop over j
+  f_elems.get();
 
   // write data to file
   auto writer = rw::writer::Writer(data.d_meshFile, data.d_outFormat,
@@ -0,0 +1,332 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include "fe3D.h"
+#include "rw/writer.h"           // definition of vtk and msh writer interface
+#include "util/point.h"          // definition of Point3
+#include "util/feElementDefs.h"  // definition of fe element type
+#include "util/compare.h"        // compare real numbers
+#include <cmath>
+#include <hpx/include/parallel_algorithm.hpp>
+#include <iostream>
+#include <yaml-cpp/yaml.h>  // YAML reader
+
+namespace {
+
+struct InpData {
+  std::string d_pathFile;
+  std::string d_meshFile;
+  std::string d_outFormat;
+  std::pair<std::vector<double>, std::vector<double>> d_domain;
+  double d_horizon;
+  size_t d_r;
+  double d_h;
+  std::string d_meshType;
+  bool d_isFd;
+  std::string d_compressType;
+
+  InpData()
+      : d_domain(std::make_pair(std::vector<double>(3, 0.),
+                                std::vector<double>(3, 0.))),
+        d_horizon(0.),
+        d_r(1),
+        d_h(0.),
+        d_isFd(false){};
+};
+
+void readInputFile(InpData *data, YAML::Node config) {
+  // read output path, filenames
+  data->d_pathFile = "./";
+  data->d_meshFile = "./mesh";
+  data->d_outFormat = "vtu";
+  if (config["Output"]) {
+    if (config["Output"]["Path"])
+      data->d_pathFile = config["Output"]["Path"].as<std::string>() + "/";
+
+    data->d_meshFile = data->d_pathFile;
+    if (config["Output"]["Mesh"])
+      data->d_meshFile += config["Output"]["Mesh"].as<std::string>();
+    else
+      data->d_meshFile += "mesh";
+
+    if (config["Output"]["File_Format"])
+      data->d_outFormat = config["Output"]["File_Format"].as<std::string>();
+  }
+
+  if (config["Domain"]) {
+    std::vector<double> d;
+    for (auto e : config["Domain"]) d.push_back(e.as<double>());
+
+    if (d.size() != 6) {
+      std::cerr << "Error: Domain in 3-d requires 6 values, coordinates of "
+                   "lower corner followed by coordinates of upper corner.\n";
+      exit(1);
+    }
+
+    for (size_t dof = 0; dof < 3; dof++) {
+      data->d_domain.first[dof] = d[dof];
+      data->d_domain.second[dof] = d[dof + 3];
+    }
+  } else {
+    std::cerr << "Error: Domain data is not provided in mesh input file.\n";
+    exit(1);
+  }
+
+  if (config["Horizon"])
+    data->d_horizon = config["Horizon"].as<double>();
+  else {
+    std::cerr << "Error: Horizon is not provided in mesh input file.\n";
+    exit(1);
+  }
+
+  if (config["Horizon_h_Ratio"]) {
+    data->d_r = config["Horizon_h_Ratio"].as<size_t>();
+    data->d_h = data->d_horizon / double(data->d_r);
+  }
+
+  if (config["Mesh_Size"])
+    data->d_h = config["Mesh_Size"].as<double>();
+  else {
+    if (!config["Horizon_h_Ratio"]) {
+      std::cerr << "Error: Can not calculate mesh size. Either provide "
+                   "Horizon_h_Ratio or Mesh_Size.\n";
+      exit(1);
+    }
+  }
+
+  if (config["Mesh_Type"])
+    data->d_meshType = config["Mesh_Type"].as<std::string>();
+  else
+    data->d_meshType = "uniform_hex";
+
+  if (config["Is_FD"])
+    data->d_isFd = config["Is_FD"].as<bool>();
+  else
+    data->d_isFd = false;
+
+  if (config["Compress_Type"])
+    data->d_compressType = config["Compress_Type"].as<std::string>();
+}
+
+/*!
+ * @brief Creates nodes and nodal volumes of uniform grid
+ *
+ * Domain is modified so that it is multiple of mesh size. Node (i, j, k) has
+ * id (k * (ny + 1) + j) * (nx + 1) + i.
+ */
+void createNodes(InpData *data, size_t &nx, size_t &ny, size_t &nz,
+                 std::vector<util::Point3> *nodes,
+                 std::vector<double> *nodal_vols) {
+  size_t n[3];
+  for (size_t dof = 0; dof < 3; dof++) {
+    // modify boundary so that discretization is good
+    n[dof] = (data->d_domain.second[dof] - data->d_domain.first[dof]) /
+             data->d_h;
+    auto B = data->d_domain.first[dof] + n[dof] * data->d_h;
+    if (util::compare::definitelyLessThan(B, data->d_domain.second[dof]))
+      data->d_domain.second[dof] = B;
+  }
+  nx = n[0];
+  ny = n[1];
+  nz = n[2];
+
+  size_t num_nodes = (nx + 1) * (ny + 1) * (nz + 1);
+  nodes->resize(num_nodes);
+  nodal_vols->resize(num_nodes);
+
+  const auto x0 = data->d_domain.first;
+  const auto h = data->d_h;
+
+  // create nodal data (each task creates one line of nodes in x-direction)
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      (ny + 1) * (nz + 1),
+      [nodes, nodal_vols, nx, ny, nz, &x0, h](boost::uint64_t jk) {
+        size_t j = jk % (ny + 1);
+        size_t k = jk / (ny + 1);
+        for (size_t i = 0; i <= nx; i++) {
+          // node number
+          size_t n = jk * (nx + 1) + i;
+          (*nodes)[n] = util::Point3(x0[0] + double(i) * h,
+                                     x0[1] + double(j) * h,
+                                     x0[2] + double(k) * h);
+
+          double vol = h * h * h;
+          if (i == 0 || i == nx) vol *= 0.5;
+          if (j == 0 || j == ny) vol *= 0.5;
+          if (k == 0 || k == nz) vol *= 0.5;
+          (*nodal_vols)[n] = vol;
+        }
+      });
+  f.get();
+}
+
+/*!
+ * @brief Gets ids of the eight nodes of cube (i, j, k) of uniform grid
+ *
+ * Node c of cube is at (i + c % 2, j + (c / 2) % 2, k + c / 4).
+ */
+void cubeNodes(size_t i, size_t j, size_t k, size_t nx, size_t ny,
+               size_t *ns) {
+  for (size_t c = 0; c < 8; c++)
+    ns[c] = ((k + c / 4) * (ny + 1) + j + (c / 2) % 2) * (nx + 1) + i + c % 2;
+}
+
+void writeMesh(const InpData &data, const std::vector<util::Point3> &nodes,
+               const std::vector<double> &nodal_vols, size_t element_type,
+               const std::vector<size_t> *en_con) {
+  auto writer = rw::writer::Writer(data.d_meshFile, data.d_outFormat,
+                                   data.d_compressType);
+  if (en_con)
+    writer.appendMesh(&nodes, element_type, en_con);
+  else
+    writer.appendNodes(&nodes);
+  writer.appendPointData("Node_Volume", &nodal_vols);
+  writer.addTimeStep(0.);
+  writer.close();
+}
+
+}  // namespace
+
+void tools::mesh::uniformHex(const std::string &filename) {
+  // read input file
+  YAML::Node config = YAML::LoadFile(filename);
+  InpData data;
+  readInputFile(&data, config);
+
+  // nodal data
+  size_t nx, ny, nz;
+  std::vector<util::Point3> nodes;
+  std::vector<double> nodal_vols;
+  createNodes(&data, nx, ny, nz, &nodes, &nodal_vols);
+
+  // if this mesh is being generated for finite difference simulation
+  // we do not require element-node connectivity
+  if (data.d_isFd) {
+    writeMesh(data, nodes, nodal_vols, 0, nullptr);
+    return;
+  }
+
+  // we reached here means we also compute element-node connectivity
+  size_t element_type = util::vtk_type_hexahedron;
+  size_t num_elems = nx * ny * nz;
+  std::vector<size_t> en_con(8 * num_elems, 0);
+
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      ny * nz, [&en_con, nx, ny](boost::uint64_t jk) {
+        size_t j = jk % ny;
+        size_t k = jk / ny;
+        for (size_t i = 0; i < nx; i++) {
+          // element number
+          auto n = jk * nx + i;
+
+          size_t ns[8];
+          cubeNodes(i, j, k, nx, ny, ns);
+
+          // bottom face and then top face in anti clockwise order
+          auto e = en_con.data() + 8 * n;
+          e[0] = ns[0];
+          e[1] = ns[1];
+          e[2] = ns[3];
+          e[3] = ns[2];
+          e[4] = ns[4];
+          e[5] = ns[5];
+          e[6] = ns[7];
+          e[7] = ns[6];
+        }
+      });
+  f.get();
+
+  writeMesh(data, nodes, nodal_vols, element_type, &en_con);
+}
+
+//
+// Cube with nodes
+//
+//          6 o---------o 7
+//           /|        /|
+//          / |       / |
+//       4 o---------o 5|
+//         |  o------|--o 3
+//         | / 2     | /
+//         |/        |/
+//         o---------o
+//         0         1
+//
+// is divided into six tetrahedrons (0,1,3,7), (0,5,1,7), (0,3,2,7),
+// (0,2,6,7), (0,4,5,7), (0,6,4,7) which share the diagonal 0-7. Since all
+// cubes are divided in same way, faces of tetrahedrons of neighboring cubes
+// match. Nodes of each tetrahedron are ordered so that it has positive
+// volume.
+//
+void tools::mesh::uniformTet(const std::string &filename) {
+  // read input file
+  YAML::Node config = YAML::LoadFile(filename);
+  InpData data;
+  readInputFile(&data, config);
+
+  // nodal data
+  size_t nx, ny, nz;
+  std::vector<util::Point3> nodes;
+  std::vector<double> nodal_vols;
+  createNodes(&data, nx, ny, nz, &nodes, &nodal_vols);
+
+  // if this mesh is being generated for finite difference simulation
+  // we do not require element-node connectivity
+  if (data.d_isFd) {
+    writeMesh(data, nodes, nodal_vols, 0, nullptr);
+    return;
+  }
+
+  // we reached here means we also compute element-node connectivity
+  size_t element_type = util::vtk_type_tetra;
+  size_t num_elems = 6 * nx * ny * nz;
+  std::vector<size_t> en_con(4 * num_elems, 0);
+
+  const size_t tets[6][4] = {{0, 1, 3, 7}, {0, 5, 1, 7}, {0, 3, 2, 7},
+                             {0, 2, 6, 7}, {0, 4, 5, 7}, {0, 6, 4, 7}};
+
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      ny * nz, [&en_con, &tets, nx, ny](boost::uint64_t jk) {
+        size_t j = jk % ny;
+        size_t k = jk / ny;
+        for (size_t i = 0; i < nx; i++) {
+          // first element in cube
+          auto n = 6 * (jk * nx + i);
+
+          size_t ns[8];
+          cubeNodes(i, j, k, nx, ny, ns);
+
+          for (size_t t = 0; t < 6; t++)
+            for (size_t c = 0; c < 4; c++)
+              en_con[4 * (n + t) + c] = ns[tets[t][c]];
+        }
+      });
+  f.get();
+
+  writeMesh(data, nodes, nodal_vols, element_type, &en_con);
+}
+
+void tools::mesh::fe3D(const std::string &filename) {
+  // read input file
+  YAML::Node config = YAML::LoadFile(filename);
+  InpData data;
+  readInputFile(&data, config);
+
+  if (data.d_meshType == "uniform_hex")
+    tools::mesh::uniformHex(filename);
+  else if (data.d_meshType == "uniform_tet")
+    tools::mesh::uniformTet(filename);
+  else {
+    std::cerr << "Error: Check Mesh_Type data. Currently only uniform_hex"
+                 " and uniform_tet is implemented.\n";
+    exit(1);
+  }
+}
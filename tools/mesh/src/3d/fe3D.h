@@ -0,0 +1,46 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2019 Prashant K. Jha
+//  Copyright (c) 2019 Patrick Diehl
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#ifndef TOOLS_MESH_THREED_H
+#define TOOLS_MESH_THREED_H
+
+#include <string>
+
+namespace tools {
+namespace mesh {
+
+/*!
+ * @brief Generates uniform mesh in 3-d and writes the data to files
+ * specified in input filename
+ * @param filename Name of YAML input file
+ */
+void fe3D(const std::string &filename);
+
+/*!
+ * @brief Generates uniform hexahedral mesh in 3-d and writes the data to
+ * files specified in input filename
+ * @param filename Name of YAML input file
+ */
+void uniformHex(const std::string &filename);
+
+/*!
+ * @brief Generates uniform tetrahedral mesh in 3-d and writes the data to
+ * files specified in input filename
+ *
+ * Each cube of uniform grid is divided into six tetrahedrons sharing the
+ * diagonal of cube from its lower corner to its upper corner.
+ *
+ * @param filename Name of YAML input file
+ */
+void uniformTet(const std::string &filename);
+
+} // namespace mesh
+
+} // namespace tools
+
+#endif // TOOLS_MESH_THREED_H
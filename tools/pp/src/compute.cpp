@@ -25,7 +25,10 @@
 #include "util/fastMethods.h"        // max and min operation
 #include "util/feElementDefs.h"      // definition of fe element type
 #include "util/utilGeom.h"           // definition of isPointInsideRectangle
+#include <algorithm>
 #include <cmath>
+#include <deque>
+#include <hpx/include/async.hpp>
 #include <hpx/include/parallel_algorithm.hpp>
 #include <iostream>
 #include <yaml-cpp/yaml.h>  // YAML reader
@@ -139,6 +142,7 @@ tools::pp::Compute::Compute(const std::string &filename)
       d_dtOutChange(0),
       d_writerReady(false),
       d_uPlus(false),
+      d_numPrefetch(2),
       d_dtN(0),
       d_dtStart(0),
       d_dtEnd(0),
@@ -146,6 +150,10 @@ tools::pp::Compute::Compute(const std::string &filename)
       d_fnErrMsg(""),
       d_needDamageZ(false),
       d_needNeighborList(false),
+      d_incrementalDamage(false),
+      d_damageFullUpdate(10),
+      d_damageFrontZ(0.5),
+      d_numDamageUpdates(0),
       d_outputDeck_p(nullptr),
       d_fractureDeck_p(nullptr),
       d_matDeck_p(nullptr),
@@ -154,6 +162,17 @@ tools::pp::Compute::Compute(const std::string &filename)
   d_dataManager_p = new data::DataManager();
   init();
 
+  // grid for search of nodes close to given point
+  d_refNodeGrid.build(d_dataManager_p->getMeshP()->getNodesP(),
+                      d_dataManager_p->getMeshP()->getMeshSize());
+
+  // grid for search of elements is needed only for J-integral
+  bool need_elem_grid = false;
+  if (d_dataManager_p->getMeshP()->getNumElements() > 0)
+    for (const auto &data : d_computeData)
+      if (data.d_computeJInt_p) need_elem_grid = true;
+  if (need_elem_grid) buildElementGrid(&d_refElemGrid);
+
   // build neighbor list if we need it
   if (d_needNeighborList) {
     std::cout << "PP: Computing neighbor list\n";
@@ -166,19 +185,51 @@ tools::pp::Compute::Compute(const std::string &filename)
   // take the smaller output interval as dt_out
   size_t dt_out = d_outputDeck_p->d_dtOutCriteria;
   size_t dt_out_old = d_outputDeck_p->d_dtOutOld;
-  size_t dt_interval_factor = dt_out_old / dt_out;
 
-  for (d_nOut = 1; d_nOut <= d_dtN; d_nOut++) {
-    size_t current_step = d_nOut * dt_out;
+  // list of output files which need to be processed
+  std::vector<size_t> out_steps;
+  for (size_t n = 1; n <= d_dtN; n++) {
     // proceed every dt_out_old interval if the current time step is
     // less than the time step when the change in output will happen
-    bool process_iN = true;
-    if (d_nOut < d_dtOutChange)
-      if (current_step % dt_out_old != 0) process_iN = false;
+    if (n < d_dtOutChange && (n * dt_out) % dt_out_old != 0) continue;
 
-    if (!process_iN) continue;
+    // see if we need to read the data
+    bool read_file = false;
+    for (const auto &data : d_computeData) {
+      // modify read file flag only if it is false
+      if (!read_file) read_file = (n >= data.d_start && n <= data.d_end);
+    }
+
+    if (read_file) out_steps.push_back(n);
+  }
+
+  // Output files are read asynchronously ahead of the file being processed
+  // and output files of post-processing are written asynchronously while next
+  // file is processed. Number of files in flight is bounded by
+  // d_numPrefetch so that memory use remains bounded.
+  std::deque<hpx::future<tools::pp::OutputStepData>> reads;
+  std::deque<hpx::future<void>> writes;
+  size_t next_read = 0;
+  auto prefetch = [this, &reads, &next_read, &out_steps]() {
+    while (next_read < out_steps.size() && reads.size() < d_numPrefetch) {
+      size_t n = out_steps[next_read++];
+      reads.push_back(hpx::async([this, n]() { return readOutputStep(n); }));
+    }
+  };
+
+  prefetch();
+  while (!reads.empty()) {
+    auto step_data = reads.front().get();
+    reads.pop_front();
+
+    // issue next reads while this file is processed
+    prefetch();
+
+    d_nOut = step_data.d_n;
+    size_t current_step = d_nOut * dt_out;
 
     // get correct factor for dt interval
+    size_t dt_interval_factor = dt_out_old / dt_out;
     if (d_nOut >= d_dtOutChange) dt_interval_factor = 1;
 
     // current time
@@ -186,27 +237,9 @@ tools::pp::Compute::Compute(const std::string &filename)
 
     std::cout << "PP_fe2D: Processing output file = " << d_nOut << "\n";
 
-    // mesh filename to read displacement and velocity
-    std::string sim_out_filename =
-        d_simOutFilename + std::to_string(d_nOut) + ".vtu";
-
-    // see if we need to read the data
-    bool read_file = false;
-    for (const auto &data : d_computeData) {
-      // modify read file flag only if it is false
-      if (!read_file)
-        read_file = (d_nOut >= data.d_start && d_nOut <= data.d_end);
-    }
-
-    if (!read_file) continue;
-
     // get displacement and velocity
-    if (d_outputDeck_p->d_outFormat == "vtu")
-      rw::reader::readVtuFileRestart(sim_out_filename, &d_u, &d_v,
-                                     d_dataManager_p->getMeshP()->getNodesP());
-    else if (d_outputDeck_p->d_outFormat == "msh")
-      rw::reader::readMshFileRestart(sim_out_filename, &d_u, &d_v,
-                                     d_dataManager_p->getMeshP()->getNodesP());
+    d_u = std::move(step_data.d_u);
+    d_v = std::move(step_data.d_v);
 
     if (d_uPlus) {
       auto f2 = hpx::parallel::for_loop(
@@ -221,6 +254,11 @@ tools::pp::Compute::Compute(const std::string &filename)
       f2.get();
     }
 
+    // update grids for search in current configuration
+    d_curNodeGrid.build(d_dataManager_p->getMeshP()->getNodesP(),
+                        d_dataManager_p->getMeshP()->getMeshSize(), &d_u);
+    if (need_elem_grid) buildElementGrid(&d_curElemGrid, &d_u);
+
     bool damage_computed = false;
     // loop over compute sets and do as instructed in input file
     for (d_nC = 0; d_nC < d_computeData.size(); d_nC++) {
@@ -251,30 +289,20 @@ tools::pp::Compute::Compute(const std::string &filename)
       d_outFilename = d_outPreTag + d_currentData->d_tagFilename + "_" +
                       std::to_string(d_nOut);
 
-      // writer
-      rw::writer::Writer writer;
+      // writer (owned by the asynchronous write task once data is appended)
+      auto writer_p = new rw::writer::Writer();
+      auto &writer = *writer_p;
       d_writerReady = false;
 
       // get damage at nodes if required
       if (d_needDamageZ) {
         if (!damage_computed) {
-          if (!d_Z.empty()) d_Z.clear();
-          // check if the input file has damage data
-          if (rw::reader::vtuHasPointData(sim_out_filename, "Damage_Z"))
-            rw::reader::readVtuFilePointData(sim_out_filename, "Damage_Z",
-                                             &d_Z);
+          if (step_data.d_readZ)
+            d_Z = std::move(step_data.d_Z);
           else {
-            // see if file for damage is provided
-            if (!d_fileZ.empty()) {
-              std::string fn = d_fileZ + "_" + std::to_string(d_nOut) + ".vtu";
-              if (!rw::reader::readVtuFilePointData(fn, d_tagZ, &d_Z)) {
-                std::cerr << "Error: Can not read file = " << fn
-                          << " or data = " << d_tagZ
-                          << " not available in vtu file.\n";
-                exit(1);
-              }
-            } else
-              computeDamage(&writer, &d_Z, false);
+            // damage of previous file is needed in incremental computation
+            if (!d_incrementalDamage && !d_Z.empty()) d_Z.clear();
+            computeDamage(&writer, &d_Z, false);
           }
 
           damage_computed = true;
@@ -296,14 +324,80 @@ tools::pp::Compute::Compute(const std::string &filename)
         writer.appendPointData("Damage_Z", &d_Z);
       }
 
-      // close file
-      if (d_writerReady) writer.close();
+      // close file (data is copied to writer when appended so the file can be
+      // written while next compute set or file is processed; hdf5 output is
+      // written to single file and therefore written synchronously)
+      if (!d_writerReady)
+        delete writer_p;
+      else if (d_currentData->d_outFormat == "hdf5") {
+        writer.close();
+        delete writer_p;
+      } else {
+        while (writes.size() >= d_numPrefetch) {
+          writes.front().get();
+          writes.pop_front();
+        }
+        writes.push_back(hpx::async([writer_p]() {
+          writer_p->close();
+          delete writer_p;
+        }));
+      }
     }  // loop compute set
   }    // loop simulation output
 
+  // wait for pending writes
+  for (auto &w : writes) w.get();
+
   finalize();
 }
 
+tools::pp::OutputStepData
+tools::pp::Compute::readOutputStep(const size_t &n) const {
+  auto data = tools::pp::OutputStepData();
+  data.d_n = n;
+
+  // mesh filename to read displacement and velocity
+  std::string sim_out_filename = d_simOutFilename + std::to_string(n) + ".vtu";
+
+  // get displacement and velocity (simulation output has nodes in the order
+  // of mesh file)
+  const auto mesh = d_dataManager_p->getMeshP();
+  auto nodes = mesh->getNodes();
+  mesh->toOriginalOrder(&nodes);
+
+  if (d_outputDeck_p->d_outFormat == "vtu")
+    rw::reader::readVtuFileRestart(sim_out_filename, &data.d_u, &data.d_v,
+                                   &nodes);
+  else if (d_outputDeck_p->d_outFormat == "msh")
+    rw::reader::readMshFileRestart(sim_out_filename, &data.d_u, &data.d_v,
+                                   &nodes);
+
+  mesh->fromOriginalOrder(&data.d_u);
+  mesh->fromOriginalOrder(&data.d_v);
+
+  // get damage if required
+  if (d_needDamageZ) {
+    // check if the input file has damage data
+    if (rw::reader::vtuHasPointData(sim_out_filename, "Damage_Z"))
+      data.d_readZ = rw::reader::readVtuFilePointData(sim_out_filename,
+                                                      "Damage_Z", &data.d_Z);
+    else if (!d_fileZ.empty()) {
+      // see if file for damage is provided
+      std::string fn = d_fileZ + "_" + std::to_string(n) + ".vtu";
+      if (!rw::reader::readVtuFilePointData(fn, d_tagZ, &data.d_Z)) {
+        std::cerr << "Error: Can not read file = " << fn
+                  << " or data = " << d_tagZ << " not available in vtu file.\n";
+        exit(1);
+      }
+      data.d_readZ = true;
+    }
+
+    if (data.d_readZ) mesh->fromOriginalOrder(&data.d_Z);
+  }
+
+  return data;
+}
+
 void tools::pp::Compute::init() {
   auto config = YAML::LoadFile(d_inpFilename);
 
@@ -424,6 +518,22 @@ void tools::pp::Compute::init() {
   if (config["Compute"]["Take_U_Plus"])
     d_uPlus = config["Compute"]["Take_U_Plus"].as<bool>();
 
+  // incremental damage computation
+  if (config["Compute"]["Incremental_Damage"])
+    d_incrementalDamage = config["Compute"]["Incremental_Damage"].as<bool>();
+
+  if (config["Compute"]["Damage_Full_Update"])
+    d_damageFullUpdate = config["Compute"]["Damage_Full_Update"].as<size_t>();
+
+  if (config["Compute"]["Damage_Front_Z"])
+    d_damageFrontZ = config["Compute"]["Damage_Front_Z"].as<double>();
+
+  // number of simulation output files read ahead (at least one file is read
+  // ahead)
+  if (config["Prefetch_Files"])
+    d_numPrefetch =
+        std::max(config["Prefetch_Files"].as<size_t>(), size_t(1));
+
   // read compute instruction
   auto num_compute = config["Compute"]["Sets"].as<size_t>();
   for (size_t c = 0; c < num_compute; c++) {
@@ -870,6 +980,10 @@ void tools::pp::Compute::initWriter(rw::writer::Writer *writer,
 
   writer->open(d_outFilename, d_currentData->d_outFormat,
                d_currentData->d_compressType);
+
+  // write nodal data in the order of nodes in mesh file
+  writer->setNodeOrder(&d_dataManager_p->getMeshP()->getOriginalNodeIds());
+
   // append mesh (check if only nodes need to be written)
   if (d_currentData->d_outOnlyNodes)
     writer->appendNodes(d_dataManager_p->getMeshP()->getNodesP(), u);
@@ -947,9 +1061,9 @@ void tools::pp::Compute::transformV(rw::writer::Writer *writer) {
       for (auto x : data->d_markVPts) {
         size_t i_found;
         if (data->d_markVPtsAreInCurrentConfig)
-          i_found = findNode(x, d_dataManager_p->getMeshP()->getNodesP(), &d_u);
+          i_found = size_t(d_curNodeGrid.findClosest(x));
         else
-          i_found = findNode(x, d_dataManager_p->getMeshP()->getNodesP());
+          i_found = size_t(d_refNodeGrid.findClosest(x));
 
         // modify v_new
         v_mark[i_found] = util::Point3();
@@ -1172,23 +1286,60 @@ void tools::pp::Compute::computeDamage(rw::writer::Writer *writer,
   //  if (!d_currentData->d_damageAtNodes)
   //    return;
 
-  if (Z->size() != d_dataManager_p->getMeshP()->getNumNodes())
-    Z->resize(d_dataManager_p->getMeshP()->getNumNodes());
+  const auto num_nodes = d_dataManager_p->getMeshP()->getNumNodes();
+  bool full_update = !d_incrementalDamage || Z->size() != num_nodes ||
+                     d_bondOffset.size() != num_nodes + 1;
+  if (!full_update && d_damageFullUpdate > 0)
+    full_update = d_numDamageUpdates % d_damageFullUpdate == 0;
+  d_numDamageUpdates++;
+
+  if (Z->size() != num_nodes)
+    Z->resize(num_nodes);
 
   if (d_dataManager_p->getNeighborP() == nullptr)
     safeExit(
         "Error: Need neighbor list to compute damage. This should have "
         "been created at the beginning.\n");
 
+  // initialize state of bonds
+  if (d_incrementalDamage && d_bondOffset.size() != num_nodes + 1) {
+    d_bondOffset = std::vector<size_t>(num_nodes + 1, 0);
+    for (size_t i = 0; i < num_nodes; i++)
+      d_bondOffset[i + 1] =
+          d_bondOffset[i] +
+          d_dataManager_p->getNeighborP()->getNeighbors(i).size();
+    d_bondBroken = std::vector<uint8_t>(d_bondOffset[num_nodes], 0);
+    d_damageFront.clear();
+  }
+
+  // nodes to process
+  std::vector<size_t> nodes;
+  if (full_update) {
+    nodes.resize(num_nodes);
+    for (size_t i = 0; i < num_nodes; i++) nodes[i] = i;
+  } else {
+    // damage front and its neighbors
+    for (const auto &i : d_damageFront) {
+      nodes.push_back(i);
+      for (const auto &j : d_dataManager_p->getNeighborP()->getNeighbors(i))
+        nodes.push_back(j);
+    }
+    std::sort(nodes.begin(), nodes.end());
+    nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+  }
+
   auto f = hpx::parallel::for_loop(
       hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
-      d_dataManager_p->getMeshP()->getNumNodes(),
-      [&Z, this](boost::uint64_t i) {
+      nodes.size(),
+      [&Z, &nodes, this](boost::uint64_t k) {
+        auto i = nodes[k];
         auto xi = d_dataManager_p->getMeshP()->getNode(i);
 
         double locz = 0.;
-        auto i_neighs = d_dataManager_p->getNeighborP()->getNeighbors(i);
-        for (const auto &j : i_neighs) {
+        const auto &i_neighs =
+            d_dataManager_p->getNeighborP()->getNeighbors(i);
+        for (size_t b = 0; b < i_neighs.size(); b++) {
+          auto j = i_neighs[b];
           if (util::compare::definitelyGreaterThan(
                   xi.dist(d_dataManager_p->getMeshP()->getNode(j)),
                   d_dataManager_p->getModelDeckP()->d_horizon) ||
@@ -1200,6 +1351,14 @@ void tools::pp::Compute::computeDamage(rw::writer::Writer *writer,
             auto Sr = std::abs(d_material_p->getS(xj - xi, d_u[j] - d_u[i])) /
                       d_material_p->getSc(xj.dist(xi));
 
+            // broken bond remains broken
+            if (d_incrementalDamage) {
+              auto &broken = d_bondBroken[d_bondOffset[i] + b];
+              if (broken == 0 && !util::compare::definitelyLessThan(Sr, 1.))
+                broken = 1;
+              if (broken == 1 && Sr < 1.) Sr = 1.;
+            }
+
             if (util::compare::definitelyLessThan(locz, Sr)) locz = Sr;
           }
         }  // loop over neighbors
@@ -1208,6 +1367,14 @@ void tools::pp::Compute::computeDamage(rw::writer::Writer *writer,
       });  // parallel loop over nodes
   f.get();
 
+  // update damage front (all nodes in previous front have been processed)
+  if (d_incrementalDamage) {
+    d_damageFront.clear();
+    for (const auto &i : nodes)
+      if (!util::compare::definitelyLessThan((*Z)[i], d_damageFrontZ))
+        d_damageFront.push_back(i);
+  }
+
   if (!perf_out) return;
 
   if (!d_writerReady) initWriter(writer, &d_u);
@@ -1364,12 +1531,11 @@ void tools::pp::Compute::computeJIntegral() {
 
   // compute nodes and elements list for search
   std::vector<size_t> search_nodes;
-  std::vector<size_t> search_elems;
   listElemsAndNodesInDomain(cd,
                             d_dataManager_p->getModelDeckP()->d_horizon +
                                 2. * d_dataManager_p->getMeshP()->getMeshSize(),
                             d_dataManager_p->getMeshP()->getMeshSize(),
-                            &search_nodes, &search_elems, calc_in_ref);
+                            &search_nodes, nullptr, calc_in_ref);
 
   //
   // Compute contour integral
@@ -1450,125 +1616,124 @@ void tools::pp::Compute::computeJIntegral() {
     //  collect all quad points
     // std::vector<util::Point3> quad_points(2 * N, util::Point3());
 
-    //    auto f = hpx::parallel::for_loop(
-    //        hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
-    //        N,
-    //        [&ced, N, h, cd, ctip, &line_quad, search_nodes, search_elems,
-    //         E, this, calc_in_ref](boost::uint64_t I) {
-    for (size_t I = 0; I < N; I++) {
-      double kinetic_energy_q = 0.;
-      double pd_energy_q = 0.;
-      double elastic_energy_q = 0.;
-      util::Point3 dot_u_q = util::Point3();
-
-      double pd_strain_energy = 0.;
-      double pd_strain_energy_rate = 0.;
-      double kinetic_energy_rate = 0.;
-      double elastic_internal_work_rate = 0.;
-
-      // normal to edge
-      util::Point3 edge_normal = util::Point3();
-
-      // dot product of normal to edge and crack velocity direction
-      double n_dot_n_c = 0.;
-
-      // dot product of normal to edge and crack velocity
-      double n_dot_v_c = 0.;
-
-      // line element
-      auto x1 = 0.;
-      auto x2 = 0.;
-      if (E == 0) {
-        // discretization of horizontal line
-        x1 = cd.first.d_x + double(I) * h_contour;
-        x2 = cd.first.d_x + double(I + 1) * h_contour;
-        if (I == N - 1) x2 = cd.second.d_x;
-      } else {
-        // discretization of vertical line
-        x1 = cd.first.d_y + double(I) * h_contour;
-        x2 = cd.first.d_y + double(I + 1) * h_contour;
-        if (I == N - 1) x2 = cd.second.d_y;
-      }
-
-      // get quadrature points
-      auto qds = line_quad.getQuadPoints(std::vector<util::Point3>{
-          util::Point3(x1, 0., 0.), util::Point3(x2, 0., 0.)});
-
-      // loop over quad points
-      for (auto qd : qds) {
-        for (int top_side = 0; top_side < 2; top_side++) {
-          // process data
-          util::Point3 qp = qd.d_p;
-          processQuadPointForContour(E, top_side, cd, ctip.d_v, ctip.d_d, qp,
-                                     edge_normal, n_dot_n_c, n_dot_v_c);
-
-          // quad_points[2 * I + top_side] = qp;
-
-          // get energy density
-          getContourContribJInt(qp, &search_nodes, &search_elems, edge_normal,
-                                pd_energy_q, kinetic_energy_q, elastic_energy_q,
-                                dot_u_q, calc_in_ref, ctip);
-
-          // debug information
-          if (false) {
-            std::cout
-                << "--------------------------------------------------------\n";
-            std::cout << "E: " << E << ", I: " << I << ", qp: " << qp.printStr()
-                      << ", qw: " << qd.d_w << ", top_side: " << top_side
-                      << "\n";
-
-            std::cout << "tip: " << ctip.d_p.printStr()
-                      << ", v: " << ctip.d_v.printStr()
-                      << ", d: " << ctip.d_d.printStr()
-                      << ", edge_normal: " << edge_normal.printStr()
-                      << ", n_dot_n_c: " << n_dot_n_c
-                      << ", n_dot_v_c: " << n_dot_v_c << "\n";
-
-            std::cout << "pd_energy_q: " << pd_energy_q
-                      << ", kinetic_energy_q: " << kinetic_energy_q
-                      << ", elastic_energy_q: " << elastic_energy_q
-                      << ", pd_strain_energy: "
-                      << pd_energy_q * n_dot_n_c * qd.d_w
-                      << ", pd_strain_energy_rate: "
-                      << pd_energy_q * n_dot_v_c * qd.d_w
-                      << ", elastic_internal_work_rate: "
-                      << elastic_energy_q * qd.d_w << "\n\n";
+    // quadrature points are processed in parallel (node and element search
+    // use grids built once per output file)
+    auto f = hpx::parallel::for_loop(
+        hpx::parallel::execution::par(hpx::parallel::execution::task), 0, N,
+        [&ced, N, h_contour, &cd, &ctip, &line_quad, E, this,
+         calc_in_ref](boost::uint64_t I) {
+          double kinetic_energy_q = 0.;
+          double pd_energy_q = 0.;
+          double elastic_energy_q = 0.;
+          util::Point3 dot_u_q = util::Point3();
+
+          double pd_strain_energy = 0.;
+          double pd_strain_energy_rate = 0.;
+          double kinetic_energy_rate = 0.;
+          double elastic_internal_work_rate = 0.;
+
+          // normal to edge
+          util::Point3 edge_normal = util::Point3();
+
+          // dot product of normal to edge and crack velocity direction
+          double n_dot_n_c = 0.;
+
+          // dot product of normal to edge and crack velocity
+          double n_dot_v_c = 0.;
+
+          // line element
+          auto x1 = 0.;
+          auto x2 = 0.;
+          if (E == 0) {
+            // discretization of horizontal line
+            x1 = cd.first.d_x + double(I) * h_contour;
+            x2 = cd.first.d_x + double(I + 1) * h_contour;
+            if (I == N - 1) x2 = cd.second.d_x;
+          } else {
+            // discretization of vertical line
+            x1 = cd.first.d_y + double(I) * h_contour;
+            x2 = cd.first.d_y + double(I + 1) * h_contour;
+            if (I == N - 1) x2 = cd.second.d_y;
           }
 
-          //          // Debug
-          //          //  Must be deleted after testing
-          //          if ((data->d_crackOrient == -1 and
-          //               util::compare::definitelyGreaterThan(qd.d_p.d_x,
-          //                                                    ctip.d_p.d_x))
-          //                                                    or
-          //              (data->d_crackOrient == 1 and
-          //               util::compare::definitelyGreaterThan(qd.d_p.d_y,
-          //                                                    ctip.d_p.d_y)))
-          //                                                    {
-          // pd energy
-          pd_strain_energy += pd_energy_q * n_dot_n_c * qd.d_w;
-
-          // pd energy rate
-          pd_strain_energy_rate += pd_energy_q * n_dot_v_c * qd.d_w;
-
-          // kinetic energy rate
-          kinetic_energy_rate += kinetic_energy_q * n_dot_v_c * qd.d_w;
-
-          // elastic internal work rate
-          elastic_internal_work_rate += elastic_energy_q * qd.d_w;
-          //          }
-        }
+          // get quadrature points
+          auto qds = line_quad.getQuadPoints(std::vector<util::Point3>{
+              util::Point3(x1, 0., 0.), util::Point3(x2, 0., 0.)});
+
+          // loop over quad points
+          for (auto qd : qds) {
+            for (int top_side = 0; top_side < 2; top_side++) {
+              // process data
+              util::Point3 qp = qd.d_p;
+              processQuadPointForContour(E, top_side, cd, ctip.d_v, ctip.d_d,
+                                         qp, edge_normal, n_dot_n_c,
+                                         n_dot_v_c);
+
+              // quad_points[2 * I + top_side] = qp;
+
+              // get energy density
+              getContourContribJInt(qp, nullptr, nullptr, edge_normal,
+                                    pd_energy_q, kinetic_energy_q,
+                                    elastic_energy_q, dot_u_q, calc_in_ref,
+                                    ctip);
+
+              // debug information
+              if (false) {
+                std::cout << "-------------------------------------------------"
+                             "-------\n";
+                std::cout << "E: " << E << ", I: " << I
+                          << ", qp: " << qp.printStr() << ", qw: " << qd.d_w
+                          << ", top_side: " << top_side << "\n";
+
+                std::cout << "tip: " << ctip.d_p.printStr()
+                          << ", v: " << ctip.d_v.printStr()
+                          << ", d: " << ctip.d_d.printStr()
+                          << ", edge_normal: " << edge_normal.printStr()
+                          << ", n_dot_n_c: " << n_dot_n_c
+                          << ", n_dot_v_c: " << n_dot_v_c << "\n";
+
+                std::cout << "pd_energy_q: " << pd_energy_q
+                          << ", kinetic_energy_q: " << kinetic_energy_q
+                          << ", elastic_energy_q: " << elastic_energy_q
+                          << ", pd_strain_energy: "
+                          << pd_energy_q * n_dot_n_c * qd.d_w
+                          << ", pd_strain_energy_rate: "
+                          << pd_energy_q * n_dot_v_c * qd.d_w
+                          << ", elastic_internal_work_rate: "
+                          << elastic_energy_q * qd.d_w << "\n\n";
+              }
+
+              //          // Debug
+              //          //  Must be deleted after testing
+              //          if ((data->d_crackOrient == -1 and
+              //               util::compare::definitelyGreaterThan(
+              //                   qd.d_p.d_x, ctip.d_p.d_x)) or
+              //              (data->d_crackOrient == 1 and
+              //               util::compare::definitelyGreaterThan(
+              //                   qd.d_p.d_y, ctip.d_p.d_y))) {
+              // pd energy
+              pd_strain_energy += pd_energy_q * n_dot_n_c * qd.d_w;
+
+              // pd energy rate
+              pd_strain_energy_rate += pd_energy_q * n_dot_v_c * qd.d_w;
+
+              // kinetic energy rate
+              kinetic_energy_rate += kinetic_energy_q * n_dot_v_c * qd.d_w;
+
+              // elastic internal work rate
+              elastic_internal_work_rate += elastic_energy_q * qd.d_w;
+              //          }
+            }
 
-      }  // loop over quad points
+          }  // loop over quad points
 
-      // add energy
-      ced.d_contourPdStrainEnergies[I] = pd_strain_energy;
-      ced.d_contourPdStrainEnergiesRate[I] = pd_strain_energy_rate;
-      ced.d_contourKineticEnergiesRate[I] = kinetic_energy_rate;
-      ced.d_contourElasticInternalWorksRate[I] = elastic_internal_work_rate;
-    }
-    //    );
-    //    f.get();
+          // add energy
+          ced.d_contourPdStrainEnergies[I] = pd_strain_energy;
+          ced.d_contourPdStrainEnergiesRate[I] = pd_strain_energy_rate;
+          ced.d_contourKineticEnergiesRate[I] = kinetic_energy_rate;
+          ced.d_contourElasticInternalWorksRate[I] = elastic_internal_work_rate;
+        });
+    f.get();
 
     // {
     //   // write to csv file and exit
@@ -1918,11 +2083,19 @@ void tools::pp::Compute::listElemsAndNodesInDomain(
     const std::pair<util::Point3, util::Point3> &cd, const double &tol,
     const double &tol_elem, std::vector<size_t> *nodes,
     std::vector<size_t> *elements, bool calc_in_ref) {
-  // nodes list
+  // nodes list (search only nodes in the grid cells covering the domain)
+  const auto &grid = calc_in_ref ? d_refNodeGrid : d_curNodeGrid;
+  auto h = d_dataManager_p->getMeshP()->getMeshSize();
+  std::vector<size_t> box_nodes;
+  grid.findInBox(util::Point3(cd.first.d_x - tol - h, cd.first.d_y - tol - h,
+                              -DBL_MAX),
+                 util::Point3(cd.second.d_x + tol + h,
+                              cd.second.d_y + tol + h, DBL_MAX),
+                 &box_nodes);
+
   nodes->clear();
-  for (size_t i = 0; i < d_dataManager_p->getMeshP()->getNumNodes(); i++) {
-    auto x = d_dataManager_p->getMeshP()->getNode(i);
-    if (!calc_in_ref) x += d_u[i];
+  for (auto i : box_nodes) {
+    auto x = grid.getPoint(i);
 
     // check if node is in the bigger domain and not in smaller domain
     if (util::geometry::isPointInsideRectangle(
@@ -1931,10 +2104,11 @@ void tools::pp::Compute::listElemsAndNodesInDomain(
         !util::geometry::isPointInsideRectangle(
             x, cd.first.d_x + tol, cd.second.d_x - tol, cd.first.d_y + tol,
             cd.second.d_y - tol))
-      addUniqueToList(i, nodes);
+      nodes->push_back(i);
   }
 
   // element list
+  if (elements == nullptr) return;
   elements->clear();
   for (size_t e = 0; e < d_dataManager_p->getMeshP()->getNumElements(); e++) {
     auto ids = d_dataManager_p->getMeshP()->getElementConnectivity(e);
@@ -2031,31 +2205,34 @@ void tools::pp::Compute::interpolateUV(const util::Point3 &p, util::Point3 &up,
   bool elem_interp = false;
   if (elements != nullptr)
     if (!elements->empty()) elem_interp = true;
-  if (!elem_interp) {
+  if (!elem_interp &&
+      (elements != nullptr ||
+       !d_dataManager_p->getMeshP()->hasNodeElementConnectivity())) {
     // use piecewise constant interpolation
-    double dist = 1000.;
-    long int loc_i = -1;
-    // search for closest node
-    for (auto i : *nodes) {
-      auto xi = d_dataManager_p->getMeshP()->getNode(i);
-      if (!calc_in_ref) xi += d_u[i];
-
-      if (util::compare::definitelyLessThan(p.dist(xi), dist)) {
-        dist = p.dist(xi);
-        loc_i = i;
-      }
-    }
-    if (loc_i == -1) {
-      oss.str("");
-      oss << "Error: Can not find node closer to point p = (" << p.d_x << ", "
-          << p.d_y << ").\n";
-      safeExit(oss.str());
-    }
-    up = d_u[loc_i];
-    vp = d_v[loc_i];
-
+    interpolateUVNodes(p, up, vp, nodes, calc_in_ref);
     return;
   } else {
+    // if list of elements is not provided, search elements sharing the nodes
+    // near the point
+    std::vector<size_t> near_elements;
+    if (!elem_interp) {
+      const auto mesh = d_dataManager_p->getMeshP();
+      const auto &grid = calc_in_ref ? d_refNodeGrid : d_curNodeGrid;
+      std::vector<size_t> near_nodes;
+      grid.findInBall(p, mesh->getMeshSize(), &near_nodes);
+      auto i_closest = grid.findClosest(p);
+      if (i_closest != -1) near_nodes.push_back(size_t(i_closest));
+
+      for (auto i : near_nodes)
+        for (auto e : mesh->getNodeElementConnectivity(i))
+          near_elements.push_back(e);
+      std::sort(near_elements.begin(), near_elements.end());
+      near_elements.erase(
+          std::unique(near_elements.begin(), near_elements.end()),
+          near_elements.end());
+      elements = &near_elements;
+    }
+
     for (auto e : *elements) {
       auto ids = d_dataManager_p->getMeshP()->getElementConnectivity(e);
 
@@ -2114,15 +2291,18 @@ size_t tools::pp::Compute::interpolateUVNodes(const util::Point3 &p,
   double dist = 1000.;
   long int loc_i = -1;
   // search for closest node
-  for (auto i : *nodes) {
-    auto xi = d_dataManager_p->getMeshP()->getNode(i);
-    if (!calc_in_ref) xi += d_u[i];
+  if (nodes == nullptr)
+    loc_i = (calc_in_ref ? d_refNodeGrid : d_curNodeGrid).findClosest(p, dist);
+  else
+    for (auto i : *nodes) {
+      auto xi = d_dataManager_p->getMeshP()->getNode(i);
+      if (!calc_in_ref) xi += d_u[i];
 
-    if (util::compare::definitelyLessThan(p.dist(xi), dist)) {
-      dist = p.dist(xi);
-      loc_i = i;
+      if (util::compare::definitelyLessThan(p.dist(xi), dist)) {
+        dist = p.dist(xi);
+        loc_i = i;
+      }
     }
-  }
   if (loc_i == -1) {
     oss.str("");
     oss << "Error: Can not find node closer to point p = (" << p.d_x << ", "
@@ -2184,8 +2364,9 @@ void tools::pp::Compute::getContourContribJInt(
       if (util::compare::definitelyGreaterThan(rjq, check_low))
         volj *= (check_up - rjq) / h;
 
-      bool fracture_state = false;
-      auto ef = d_material_p->getBondEF(node_p, j);
+      // energy is read without updating the fracture state as contour points
+      // are processed in parallel
+      auto ef_energy = d_material_p->getBondEnergy(node_p, j);
 
       // add contribution to energy
       // Debug
@@ -2195,7 +2376,7 @@ void tools::pp::Compute::getContourContribJInt(
       if (false) {
         double sr = std::abs(Sjq) / this->d_material_p->getSc(rjq);
         if (util::compare::definitelyGreaterThan(sr, 1.))
-          loc_pd_energy += ef.second * volj;
+          loc_pd_energy += ef_energy * volj;
       }
 
       // Debug
@@ -2203,10 +2384,10 @@ void tools::pp::Compute::getContourContribJInt(
       //  crack line
       if (false) {
         if (doesBondIntersectCrack(xj, p, ctip, crack_orient))
-          loc_pd_energy += ef.second * volj;
+          loc_pd_energy += ef_energy * volj;
       }
 
-      loc_pd_energy += ef.second * volj;
+      loc_pd_energy += ef_energy * volj;
     }  // loop over nodes for pd energy density
 
   } else {
@@ -2242,11 +2423,11 @@ void tools::pp::Compute::getContourContribJInt(
         volj *= (check_up - rjq) / h;
 
       // auto fs = this->d_fracture_p->getBondState(node_p, j);
-      auto ef_i = this->d_material_p->getBondEF(node_p, j);
-      auto ef_j = this->d_material_p->getBondEF(node_p, j);
+      auto ef_i = this->d_material_p->getBondEnergy(node_p, j);
+      auto ef_j = this->d_material_p->getBondEnergy(node_p, j);
 
       // add contribution to energy
-      loc_pd_energy += (ef_i.second + ef_j.second) * volj;
+      loc_pd_energy += (ef_i + ef_j) * volj;
     }  // loop over nodes for pd energy density
   }
 
@@ -2269,26 +2450,35 @@ void tools::pp::Compute::getContourContribJInt(
     return;
   }
 
-  // loop over elements and find the element which has quadrature point
-  // closest to the point
+  // find the element which has quadrature point closest to the point (for
+  // 1st order quadrature, quadrature point is the center of element)
   size_t e_found = 0;
-  auto dist = DBL_MAX;
-  for (const auto e : *elements) {
-    // get ids of nodes of element, coordinate of nodes, 1st order
-    // quad data, and first quad data
-    auto id_nds = d_dataManager_p->getMeshP()->getElementConnectivity(e);
-    auto nds = d_dataManager_p->getMeshP()->getElementConnectivityNodes(e);
-
-    if (!calc_in_ref) {
-      for (size_t i = 0; i < id_nds.size(); i++) nds[i] += d_u[id_nds[i]];
+  if (elements == nullptr) {
+    auto e = (calc_in_ref ? d_refElemGrid : d_curElemGrid).findClosest(p);
+    if (e < 0) {
+      delete quad;
+      return;
     }
+    e_found = size_t(e);
+  } else {
+    auto dist = DBL_MAX;
+    for (const auto e : *elements) {
+      // get ids of nodes of element, coordinate of nodes, 1st order
+      // quad data, and first quad data
+      auto id_nds = d_dataManager_p->getMeshP()->getElementConnectivity(e);
+      auto nds = d_dataManager_p->getMeshP()->getElementConnectivityNodes(e);
 
-    auto qds = quad->getQuadDatas(nds);
-    auto dx = qds[0].d_p - p;
+      if (!calc_in_ref) {
+        for (size_t i = 0; i < id_nds.size(); i++) nds[i] += d_u[id_nds[i]];
+      }
+
+      auto qds = quad->getQuadDatas(nds);
+      auto dx = qds[0].d_p - p;
 
-    if (dist < dx.length()) {
-      dist = dx.length();
-      e_found = e;
+      if (dx.length() < dist) {
+        dist = dx.length();
+        e_found = e;
+      }
     }
   }
 
@@ -2348,12 +2538,38 @@ void tools::pp::Compute::getContourContribJInt(
     util::Point3 stress_dot_v = sss.dot(dot_u);
     elastic_energy = stress_dot_v * normal;
   }
+
+  delete quad;
+}
+
+void tools::pp::Compute::buildElementGrid(util::PointGrid *grid,
+                                          const std::vector<util::Point3> *u) {
+  const auto mesh = d_dataManager_p->getMeshP();
+  auto centers = std::vector<util::Point3>(mesh->getNumElements());
+
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      mesh->getNumElements(), [&centers, mesh, u](boost::uint64_t e) {
+        auto ids = mesh->getElementConnectivity(e);
+        auto c = util::Point3();
+        for (auto i : ids) {
+          c += mesh->getNode(i);
+          if (u != nullptr) c += (*u)[i];
+        }
+        centers[e] = c / double(ids.size());
+      });
+  f.get();
+
+  grid->build(&centers, mesh->getMeshSize());
 }
 
 void tools::pp::Compute::updateCrack(const double &time,
                                      const std::vector<double> *Z) {
   auto compute_data = d_currentData->d_findCrackTip_p;
 
+  // find maximum of damage
+  double max_Z = util::methods::max(*Z);
+
   // loop over crack lines
   for (auto &crack : compute_data->d_cracks) {
     if (crack.d_o == 0) continue;
@@ -2361,9 +2577,6 @@ void tools::pp::Compute::updateCrack(const double &time,
     auto pb = crack.d_pb;
     auto pt = crack.d_pt;
 
-    // find maximum of damage
-    double max_Z = util::methods::max(*Z);
-
     if (util::compare::definitelyLessThan(max_Z, compute_data->d_minZAllowed)) {
       addNewCrackTip(crack, pt, time, true);
       addNewCrackTip(crack, pb, time, false);
@@ -2565,62 +2778,70 @@ void tools::pp::Compute::getRectsAndNodesForCrackTip(
   Z_t.resize(rects_t.size());
   Z_b.resize(rects_b.size());
 
-  for (size_t i = 0; i < d_dataManager_p->getMeshP()->getNumNodes(); i++) {
-    auto xi = d_dataManager_p->getMeshP()->getNode(i);
-    auto damage = (*Z)[i];
-    if (util::compare::definitelyLessThan(damage,
-                                          compute_data->d_minZAllowed) ||
-        util::compare::definitelyGreaterThan(damage,
-                                             compute_data->d_maxZAllowed))
-      continue;
-
-    for (size_t r = 0; r < rects_t.size(); r++) {
-      if (util::geometry::isPointInsideRectangle(
-              xi, rects_t[r].first.d_x, rects_t[r].second.d_x,
-              rects_t[r].first.d_y, rects_t[r].second.d_y)) {
-        if (r == 0) {
-          nodes_t[r].emplace_back(i);
-          Z_t[r].emplace_back(damage);
-        } else {
-          // see if the node i is in the previous vector
-          bool found = false;
-          for (auto j : nodes_t[r - 1]) {
-            if (j == i) {
-              found = true;
-              break;
-            }
-          }
-          if (!found) {
-            nodes_t[r].emplace_back(i);
-            Z_t[r].emplace_back(damage);
-          }
-        }
-      }
-    }  // top point
-    for (size_t r = 0; r < rects_b.size(); r++) {
-      if (util::geometry::isPointInsideRectangle(
-              xi, rects_b[r].first.d_x, rects_b[r].second.d_x,
-              rects_b[r].first.d_y, rects_b[r].second.d_y)) {
-        if (r == 0) {
-          nodes_b[r].emplace_back(i);
-          Z_b[r].emplace_back(damage);
-        } else {
-          // see if the node i is in the previous vector
-          bool found = false;
-          for (auto j : nodes_b[r - 1]) {
-            if (j == i) {
-              found = true;
-              break;
-            }
-          }
-          if (!found) {
-            nodes_b[r].emplace_back(i);
-            Z_b[r].emplace_back(damage);
+  // nodes in rectangles are found with range query on grid of nodes in
+  // reference configuration so that only nodes close to crack line are
+  // visited. Query box is slightly bigger than rectangle and nodes are then
+  // checked with same tolerance as isPointInsideRectangle. Lists are in
+  // ascending order of node ids.
+  const auto mesh = d_dataManager_p->getMeshP();
+  const double tol = 1.0E-6 * h;
+  auto find_nodes =
+      [this, mesh, compute_data, Z, &bbox, tol](
+          const std::vector<std::pair<util::Point3, util::Point3>> &rects,
+          std::vector<std::vector<size_t>> &nodes,
+          std::vector<std::vector<double>> &Zs) {
+        auto f = hpx::parallel::for_loop(
+            hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+            rects.size(),
+            [this, mesh, compute_data, Z, &bbox, tol, &rects, &nodes,
+             &Zs](boost::uint64_t r) {
+              const auto &rect = rects[r];
+              std::vector<size_t> list;
+              d_refNodeGrid.findInBox(
+                  util::Point3(rect.first.d_x - tol, rect.first.d_y - tol,
+                               bbox.first[2]),
+                  util::Point3(rect.second.d_x + tol, rect.second.d_y + tol,
+                               bbox.second[2]),
+                  &list);
+
+              for (auto i : list) {
+                auto damage = (*Z)[i];
+                if (util::compare::definitelyLessThan(
+                        damage, compute_data->d_minZAllowed) ||
+                    util::compare::definitelyGreaterThan(
+                        damage, compute_data->d_maxZAllowed))
+                  continue;
+
+                if (util::geometry::isPointInsideRectangle(
+                        mesh->getNode(i), rect.first.d_x, rect.second.d_x,
+                        rect.first.d_y, rect.second.d_y)) {
+                  nodes[r].emplace_back(i);
+                  Zs[r].emplace_back(damage);
+                }
+              }
+            });  // parallel loop over rectangles
+        f.get();
+
+        // node on common edge of two consecutive rectangles is kept only in
+        // the first rectangle
+        for (size_t r = 1; r < rects.size(); r++) {
+          size_t k = 0;
+          for (size_t j = 0; j < nodes[r].size(); j++) {
+            if (std::binary_search(nodes[r - 1].begin(), nodes[r - 1].end(),
+                                   nodes[r][j]))
+              continue;
+
+            nodes[r][k] = nodes[r][j];
+            Zs[r][k] = Zs[r][j];
+            k++;
           }
+          nodes[r].resize(k);
+          Zs[r].resize(k);
         }
-      }
-    }  // bottom point
-  }    // loop over nodes
+      };
+
+  find_nodes(rects_t, nodes_t, Z_t);  // top point
+  find_nodes(rects_b, nodes_b, Z_b);  // bottom point
 
   std::cout << "Max Z allowed = " << compute_data->d_maxZAllowed
             << ", min Z allowed = " << compute_data->d_minZAllowed << "\n";
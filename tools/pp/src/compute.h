@@ -11,6 +11,7 @@
 
 #include "util.h"
 #include "util/matrix.h" // definition of SymMatrix3
+#include "util/pointGrid.h" // definition of PointGrid
 
 // forward declarations of decks
 namespace inp {
@@ -87,6 +88,18 @@ public:
    */
   void init();
 
+  /*!
+   * @brief Reads displacement, velocity and (if required) damage from
+   * simulation output file
+   *
+   * This method does not modify the state of the class and is therefore
+   * called asynchronously to read files ahead of the file being processed.
+   *
+   * @param n Output step
+   * @return data Data read from file
+   */
+  tools::pp::OutputStepData readOutputStep(const size_t &n) const;
+
   /*!
    * @brief Finalize
    */
@@ -203,6 +216,14 @@ public:
    * x;u) \f$ is the bond-strain between points \f$y,x\f$, and \f$S_c(y,x)
    * \f$ is the critical strain.
    *
+   * If incremental damage is enabled, bonds with \f$ |S|/S_c \geq 1 \f$ are
+   * marked broken and remain broken in later output files, so that damage of
+   * node with broken bond is at least 1. Only nodes in the damage front, i.e.
+   * nodes with damage above d_damageFrontZ at previous file and their
+   * neighbors, are re-evaluated and remaining nodes keep the damage of
+   * previous file. Damage at all nodes is recomputed at first call and then
+   * after every d_damageFullUpdate calls.
+   *
    * @param writer Pointer to vtk writer
    * @param Z Pointer to nodal damage
    * @param perf_out Flag to perform output of damage data
@@ -392,6 +413,19 @@ private:
   size_t findNode(const util::Point3 &x, const std::vector<util::Point3> *nodes,
                   const std::vector<util::Point3> *u = nullptr);
 
+  /*!
+   * @brief Sorts centers of elements into grid
+   *
+   * Grid is used to find element closest to the point in J-integral
+   * calculation.
+   *
+   * @param grid Pointer to grid
+   * @param u Pointer to nodal displacement (if grid is for current
+   * configuration)
+   */
+  void buildElementGrid(util::PointGrid *grid,
+                        const std::vector<util::Point3> *u = nullptr);
+
   /*!
    * @brief Find node within contour and elements intersecting contour
    *
@@ -406,7 +440,8 @@ private:
    * @param tol Thickness for node list search
    * @param tol_elem Thickness for element list search
    * @param nodes Pointer to ids of nodes
-   * @param elements Pointer to ids of elements
+   * @param elements Pointer to ids of elements (element list is not created
+   * if this is nullptr)
    * @param calc_in_ref Calculate in reference configuration
    */
   void
@@ -461,7 +496,11 @@ private:
    * @brief Interpolates displacement and velocity at given point
    *
    * 1. For search over nodes/elements, we use list of nodes and elements which
-   * are created in listElemsAndNodesInDomain.
+   * are created in listElemsAndNodesInDomain. If list of nodes is not
+   * provided, closest node is searched using grid of nodes
+   * (d_refNodeGrid or d_curNodeGrid). If list of elements is not provided
+   * (and element-node connectivity is available), elements sharing nodes
+   * near the point are searched.
    *
    * 2. If element-node connectivity is not available, this method uses
    * piece-wise constant interpolation by searching for node closest to the
@@ -490,6 +529,17 @@ private:
                      const std::vector<size_t> *nodes,
                      const std::vector<size_t> *elements, bool calc_in_ref);
 
+  /*!
+   * @brief Assigns displacement and velocity of node closest to the point
+   *
+   * @param p Point at which we want to interpolate
+   * @param up Displacement at the point p
+   * @param vp Velocity at the point p
+   * @param nodes Pointer to ids of nodes to perform search (if nullptr, grid
+   * of all nodes is used)
+   * @param calc_in_ref Calculate in reference configuration
+   * @return i Id of closest node
+   */
   size_t interpolateUVNodes(const util::Point3 &p, util::Point3 &up,
                            util::Point3 &vp,
                      const std::vector<size_t> *nodes, bool calc_in_ref);
@@ -502,8 +552,10 @@ private:
    * at given point, see computeJIntegral() for more details.
    *
    * @param p Point
-   * @param nodes Pointer to ids of nodes to perform search
-   * @param elements Pointer to ids of elements to perform search
+   * @param nodes Pointer to ids of nodes to perform search (if nullptr, grid
+   * of all nodes is used)
+   * @param elements Pointer to ids of elements to perform search (if
+   * nullptr, grid of element centers is used)
    * @param normal Normal to the edge of contour
    * @param pd_energy Peridynamic energy density
    * @param kinetic_energy Kinetic energy density
@@ -581,6 +633,9 @@ private:
    *
    * We filter out the nodes which have damage above max
    * threshold and below min threshold defined in tools::pp::FindCrackTip.
+   * Nodes in rectangles are found using the grid of nodes in reference
+   * configuration, so the cost depends on the number of nodes near the
+   * crack line and not on the size of mesh.
    *
    * @param crack Crack data
    * @param rects_t Sequence of rectangles for search of new top (right) tip
@@ -707,6 +762,11 @@ private:
   /*! @brief Specify if we consider u(n+1) or u(n) */
   bool d_uPlus;
 
+  /*! @brief Number of simulation output files read ahead of the file being
+   * processed (and number of post-processing output files being written
+   * in background) */
+  size_t d_numPrefetch;
+
   /*! @brief Total number of output files to process */
   size_t d_dtN;
 
@@ -737,9 +797,49 @@ private:
   /*! @brief Velocity of nodes */
   std::vector<util::Point3> d_v;
 
+  /*! @brief Grid of nodes in reference configuration for point search */
+  util::PointGrid d_refNodeGrid;
+
+  /*! @brief Grid of nodes in current configuration for point search
+   *
+   * This is updated after reading displacement from simulation output.
+   */
+  util::PointGrid d_curNodeGrid;
+
+  /*! @brief Grid of element centers in reference configuration */
+  util::PointGrid d_refElemGrid;
+
+  /*! @brief Grid of element centers in current configuration
+   *
+   * This is updated after reading displacement from simulation output.
+   */
+  util::PointGrid d_curElemGrid;
+
   /*! @brief Damage of nodes */
   std::vector<double> d_Z;
 
+  /*! @brief Compute damage incrementally across output files */
+  bool d_incrementalDamage;
+
+  /*! @brief Number of incremental damage updates after which damage at all
+   * nodes is recomputed (0 means never) */
+  size_t d_damageFullUpdate;
+
+  /*! @brief Nodes with damage above this value form the damage front */
+  double d_damageFrontZ;
+
+  /*! @brief Number of damage computations performed so far */
+  size_t d_numDamageUpdates;
+
+  /*! @brief Location of first bond of node in d_bondBroken */
+  std::vector<size_t> d_bondOffset;
+
+  /*! @brief Broken state of bonds (ordered as neighbor list of nodes) */
+  std::vector<uint8_t> d_bondBroken;
+
+  /*! @brief Nodes in the damage front (sorted) */
+  std::vector<size_t> d_damageFront;
+
   /*! @brief Dilation
    *
    * In case of Rob's state based model, this will give the spherical
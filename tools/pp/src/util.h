@@ -106,6 +106,29 @@ struct SortZ {
   SortZ() : d_i(0), d_r(0), d_Z(0.){};
 };
 
+/*!
+ * @brief Datatype to hold data read from one simulation output file
+ */
+struct OutputStepData {
+
+  /*! @brief Output step */
+  size_t d_n;
+
+  /*! @brief Displacement of nodes */
+  std::vector<util::Point3> d_u;
+
+  /*! @brief Velocity of nodes */
+  std::vector<util::Point3> d_v;
+
+  /*! @brief Damage of nodes (if it is available in files) */
+  std::vector<double> d_Z;
+
+  /*! @brief Flag which indicates that damage is read */
+  bool d_readZ;
+
+  OutputStepData() : d_n(0), d_readZ(false){};
+};
+
 /*!
  * @brief Datatype to hold crack tip data
  */
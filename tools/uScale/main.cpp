@@ -7,7 +7,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 #include <algorithm>
-#include <hpx/config.hpp>
+#include <hpx/hpx_main.hpp>
 #include <boost/program_options.hpp>
 #include <iostream>
 
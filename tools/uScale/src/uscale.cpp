@@ -9,6 +9,8 @@
 #include <fe/triElem.h>
 #include <util/feElementDefs.h>
 
+#include <hpx/include/parallel_algorithm.hpp>
+#include <iostream>
 #include <limits>
 
 #include "fe/mesh.h"
@@ -32,95 +34,74 @@ namespace {
 
 /*! @brief Read input files
  *
- * @param dim Dimension
- * @param filename1 Simulation data 1
- * @param filename2 Simulation data 2
- * @param out_filename Output filename
- * @param print_screen Data should or should not be printed to screen
- * @param compare_tags List of tags data which should be compared
- * @param tolerance
+ * @param in_filename Simulation output file (or prefix of files)
+ * @param out_filename Output filename (or prefix of files)
+ * @param scale_factor Scale factor for displacement
+ * @param compress_type Compression type of output files
+ * @param files List of output numbers if processing batch of files
  * @param config YAML input file
  */
-void readInputFile(size_t &dim, std::string &in_filename,
-                   std::string &out_filename, double &scale_factor,
-                   const YAML::Node &config) {
-  if (config["Dimension"])
-    dim = config["Dimension"].as<size_t>();
-  else
-    dim = 2;
-
+void readInputFile(std::string &in_filename, std::string &out_filename,
+                   double &scale_factor, std::string &compress_type,
+                   std::vector<size_t> &files, const YAML::Node &config) {
   in_filename = config["Input_Filename"].as<std::string>();
   out_filename = config["Out_Filename"].as<std::string>();
 
   if (config["Scale_Factor"])
     scale_factor = config["Scale_Factor"].as<double>();
+
+  if (config["Compress_Type"])
+    compress_type = config["Compress_Type"].as<std::string>();
+
+  if (config["Files"]) {
+    auto e = config["Files"];
+    size_t start = e["Start"] ? e["Start"].as<size_t>() : 0;
+    size_t interval = e["Interval"] ? e["Interval"].as<size_t>() : 1;
+    if (!e["End"] || interval == 0) {
+      std::cerr << "Error: Please specify End and nonzero Interval of "
+                   "Files.\n";
+      exit(1);
+    }
+    size_t end = e["End"].as<size_t>();
+
+    for (size_t n = start; n <= end; n += interval) files.push_back(n);
+  }
 }
 
 //
-// compute error
+// scale displacement
 //
 void compute(const YAML::Node &config) {
-  size_t dim = 2;
   std::string in_filename;
   std::string out_filename;
   double scale_factor = 1.;
+  std::string compress_type;
+  std::vector<size_t> files;
 
   // read file
-  readInputFile(dim, in_filename, out_filename, scale_factor, config);
-
-  //  std::cout << in_filename << ", " << out_filename << ", " << scale_factor
-  //            << "\n";
-
-  // read input vtu file
-  // nodes current position
-  std::vector<util::Point3> nodes_current;
-  rw::reader::readVtuFileNodes(in_filename, dim, &nodes_current, false);
-
-  std::vector<util::Point3> nodes_u;
-  rw::reader::readVtuFilePointData(in_filename, "Displacement", &nodes_u);
-
-  auto data_tags = rw::reader::readVtuFilePointTags(in_filename);
-
-  // loop over nodes and modify current position
-  size_t counter = 0;
-  for (const auto &u : nodes_u) {
-    auto temp = nodes_current[counter] - u;
-    nodes_current[counter] = temp + u * scale_factor;
-
-    counter++;
-  }
-
-  // open a new vtu file and write the data
-  auto writer = rw::writer::Writer(out_filename, "vtu", "");
-  writer.appendNodes(&nodes_current);
-
-  // loop over tag in data_tags, read data from input vtu file, and
-  // write the data to output vtu file
-  for (const auto &tag : data_tags) {
-    // case when data is of double type
-    auto type = rw::getDataType(tag);
-    if (type == "double") {
-      std::vector<double> data;
-
-      // read
-      rw::reader::readVtuFilePointData(in_filename, tag, &data);
-
-      // write
-      writer.appendPointData(tag, &data);
-    } else if (type == "point") {
-      std::vector<util::Point3> data;
-
-      // read
-      rw::reader::readVtuFilePointData(in_filename, tag, &data);
-
-      // write
-      writer.appendPointData(tag, &data);
-    }
+  readInputFile(in_filename, out_filename, scale_factor, compress_type, files,
+                config);
+
+  // single file
+  if (files.empty()) {
+    rw::reader::scaleVtuFileDisplacement(in_filename, out_filename,
+                                         scale_factor, compress_type);
+    return;
   }
 
-  // get time from input vtu file
-  writer.addTimeStep(0.);
-  writer.close();
+  // batch of files are processed in parallel and each file is read once.
+  // Only the nodes are modified and remaining data is written as it is.
+  auto f = hpx::parallel::for_loop(
+      hpx::parallel::execution::par(hpx::parallel::execution::task), 0,
+      files.size(),
+      [&files, &in_filename, &out_filename, scale_factor,
+       &compress_type](boost::uint64_t i) {
+        auto n = std::to_string(files[i]);
+        rw::reader::scaleVtuFileDisplacement(in_filename + n + ".vtu",
+                                             out_filename + n, scale_factor,
+                                             compress_type);
+      });
+  f.get();
 }
 
 }  // namespace